@@ -0,0 +1,70 @@
+#include "AiLodScheduler.h"
+#include "Enemy.h"
+#include "EnemyStore.h"
+#include "Globals.h"
+
+AiLodScheduler::AiLodScheduler() : tick(0), farCursor(0), activeCount(0) {}
+
+void AiLodScheduler::Reset() {
+    tick = 0;
+    farCursor = 0;
+    activeCount = 0;
+    farSlots.clear();
+}
+
+int AiLodScheduler::GetActiveCount() const {
+    return activeCount;
+}
+
+AiLodTier AiLodScheduler::Classify(const EnemyStore& store, int slot, float cameraX, float cameraY) const {
+    float size = store.radius[slot] * 2.0f;
+    float left = cameraX - SCREEN_WIDTH / 2 - AI_LOD_SCREEN_MARGIN;
+    float right = cameraX + SCREEN_WIDTH / 2 + AI_LOD_SCREEN_MARGIN;
+    float top = cameraY - SCREEN_HEIGHT / 2 - AI_LOD_SCREEN_MARGIN;
+    float bottom = cameraY + SCREEN_HEIGHT / 2 + AI_LOD_SCREEN_MARGIN;
+    if (store.x[slot] + size > left && store.x[slot] < right &&
+        store.y[slot] + size > top && store.y[slot] < bottom) {
+        return AiLodTier::VISIBLE;
+    }
+
+    float dx = store.x[slot] + store.radius[slot] - cameraX;
+    float dy = store.y[slot] + store.radius[slot] - cameraY;
+    if (dx * dx + dy * dy < AI_LOD_NEAR_RADIUS * AI_LOD_NEAR_RADIUS) {
+        return AiLodTier::NEAR;
+    }
+    return AiLodTier::FAR;
+}
+
+void AiLodScheduler::Schedule(const std::vector<Enemy*>& enemies, EnemyStore& store, float cameraX, float cameraY) {
+    ++tick;
+    activeCount = 0;
+    farSlots.clear();
+
+    for (const auto& enemy : enemies) {
+        int slot = enemy->slot;
+        bool active = false;
+        switch (Classify(store, slot, cameraX, cameraY)) {
+            case AiLodTier::VISIBLE:
+                active = true;
+                break;
+            case AiLodTier::NEAR:
+                active = (tick + enemy->lodPhase) % AI_LOD_NEAR_INTERVAL == 0;
+                break;
+            case AiLodTier::FAR:
+                farSlots.push_back(slot);
+                break;
+        }
+        store.active[slot] = active ? 1 : 0;
+        if (active) activeCount++;
+    }
+
+    // Round-robin over the far enemies, AI_LOD_FAR_BUDGET of them per tick
+    int farCount = static_cast<int>(farSlots.size());
+    if (farCount == 0) return;
+    int budget = std::min(AI_LOD_FAR_BUDGET, farCount);
+    for (int i = 0; i < budget; ++i) {
+        store.active[farSlots[(farCursor + i) % farCount]] = 1;
+    }
+    farCursor = (farCursor + budget) % farCount;
+    activeCount += budget;
+}
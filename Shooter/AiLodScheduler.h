@@ -0,0 +1,37 @@
+#ifndef AILODSCHEDULER_H
+#define AILODSCHEDULER_H
+
+#include <vector>
+
+class Enemy;
+class EnemyStore;
+
+enum class AiLodTier {
+    VISIBLE,    // on screen (plus a margin): full update every tick
+    NEAR,       // off screen but close: full update every AI_LOD_NEAR_INTERVAL ticks
+    FAR         // everything else: shares AI_LOD_FAR_BUDGET full updates per tick
+};
+
+// Decides each tick which enemies run the full AI (Think, separation, Move)
+// and which only coast along their last velocity. The result goes into
+// EnemyStore::active. Near enemies are staggered by Enemy::lodPhase so they
+// do not all wake on the same tick; far enemies take turns round-robin.
+class AiLodScheduler {
+public:
+    AiLodScheduler();
+
+    void Schedule(const std::vector<Enemy*>& enemies, EnemyStore& store, float cameraX, float cameraY);
+    void Reset();
+
+    int GetActiveCount() const;
+
+private:
+    AiLodTier Classify(const EnemyStore& store, int slot, float cameraX, float cameraY) const;
+
+    unsigned int tick;
+    unsigned int farCursor;
+    int activeCount;
+    std::vector<int> farSlots;
+};
+
+#endif
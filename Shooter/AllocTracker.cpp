@@ -0,0 +1,161 @@
+#include "AllocTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Zero-initialised before any constructor runs, so allocations made during
+// static initialisation of other files are safe to count
+static std::atomic<Uint64> allocationCounts[ALLOC_TAG_COUNT];
+static std::atomic<Uint64> allocationBytes[ALLOC_TAG_COUNT];
+
+// Only EndFrame (simulation thread) and PrintSummary touch these
+static Uint64 frameStartCounts[ALLOC_TAG_COUNT];
+static Uint64 frameStartBytes[ALLOC_TAG_COUNT];
+static Uint64 startupCounts[ALLOC_TAG_COUNT];
+static Uint64 framesCounted = 0;
+static bool startupDone = false;
+static int worstFrameAllocations = 0;
+
+#ifdef TRACK_ALLOCATIONS
+static thread_local AllocTag currentTag = AllocTag::OTHER;
+
+static void Record(size_t size) {
+    int tag = static_cast<int>(currentTag);
+    allocationCounts[tag].fetch_add(1, std::memory_order_relaxed);
+    allocationBytes[tag].fetch_add(size, std::memory_order_relaxed);
+}
+
+AllocScope::AllocScope(AllocTag tag) : previous(currentTag) {
+    currentTag = tag;
+}
+
+AllocScope::~AllocScope() {
+    currentTag = previous;
+}
+
+// --- SDL's own allocations (surfaces, textures, mutexes) ---
+static SDL_malloc_func sdlMalloc = nullptr;
+static SDL_calloc_func sdlCalloc = nullptr;
+static SDL_realloc_func sdlRealloc = nullptr;
+static SDL_free_func sdlFree = nullptr;
+
+static void* SDLCALL TrackedMalloc(size_t size) {
+    Record(size);
+    return sdlMalloc(size);
+}
+
+static void* SDLCALL TrackedCalloc(size_t count, size_t size) {
+    Record(count * size);
+    return sdlCalloc(count, size);
+}
+
+static void* SDLCALL TrackedRealloc(void* block, size_t size) {
+    Record(size);
+    return sdlRealloc(block, size);
+}
+
+// --- Global operator new/delete ---
+void* operator new(std::size_t size) {
+    Record(size);
+    void* block = std::malloc(size ? size : 1);
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    Record(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::size_t) noexcept { std::free(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { std::free(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { std::free(block); }
+#endif
+
+bool AllocTracker::IsEnabled() {
+#ifdef TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocTracker::Install() {
+#ifdef TRACK_ALLOCATIONS
+    // The originals are still called underneath, so memory SDL allocated
+    // before this point is freed by the same allocator
+    SDL_GetMemoryFunctions(&sdlMalloc, &sdlCalloc, &sdlRealloc, &sdlFree);
+    SDL_SetMemoryFunctions(TrackedMalloc, TrackedCalloc, TrackedRealloc, sdlFree);
+#endif
+}
+
+// The first call closes the startup "frame" (asset loading, Init), which is
+// kept apart from the per-frame numbers
+AllocFrameStats AllocTracker::EndFrame() {
+    AllocFrameStats stats = {};
+    for (int tag = 0; tag < ALLOC_TAG_COUNT; ++tag) {
+        Uint64 count = allocationCounts[tag].load(std::memory_order_relaxed);
+        Uint64 bytes = allocationBytes[tag].load(std::memory_order_relaxed);
+        stats.allocations[tag] = static_cast<int>(count - frameStartCounts[tag]);
+        stats.bytes[tag] = static_cast<size_t>(bytes - frameStartBytes[tag]);
+        stats.totalAllocations += stats.allocations[tag];
+        stats.totalBytes += stats.bytes[tag];
+        frameStartCounts[tag] = count;
+        frameStartBytes[tag] = bytes;
+        if (!startupDone) startupCounts[tag] = count;
+    }
+
+    if (!startupDone) {
+        startupDone = true;
+    } else {
+        framesCounted++;
+        worstFrameAllocations = std::max(worstFrameAllocations, stats.totalAllocations);
+    }
+    return stats;
+}
+
+Uint64 AllocTracker::GetAllocationCount() {
+    Uint64 total = 0;
+    for (int tag = 0; tag < ALLOC_TAG_COUNT; ++tag) total += allocationCounts[tag].load(std::memory_order_relaxed);
+    return total;
+}
+
+const char* AllocTracker::GetTagName(AllocTag tag) {
+    switch (tag) {
+        case AllocTag::OTHER:       return "other";
+        case AllocTag::SPAWN:       return "spawn";
+        case AllocTag::SHOOT:       return "shoot";
+        case AllocTag::STREAMING:   return "streaming";
+        case AllocTag::SNAPSHOT:    return "snapshot";
+        case AllocTag::RENDER_TEXT: return "text";
+    }
+    return "?";
+}
+
+void AllocTracker::PrintSummary(std::ostream& out) {
+    if (!IsEnabled()) return;
+
+    Uint64 startupTotal = 0;
+    for (int tag = 0; tag < ALLOC_TAG_COUNT; ++tag) startupTotal += startupCounts[tag];
+    out << "Allocations: " << startupTotal << " during startup, then " << framesCounted << " frames, worst frame "
+        << worstFrameAllocations << std::endl;
+    if (framesCounted == 0) return;
+
+    for (int tag = 0; tag < ALLOC_TAG_COUNT; ++tag) {
+        Uint64 count = frameStartCounts[tag] - startupCounts[tag];
+        out << "  " << GetTagName(static_cast<AllocTag>(tag)) << ": " << count << " ("
+            << static_cast<double>(count) / framesCounted << " per frame)" << std::endl;
+    }
+}
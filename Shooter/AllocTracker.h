@@ -0,0 +1,65 @@
+#ifndef ALLOCTRACKER_H
+#define ALLOCTRACKER_H
+
+#include <SDL.h>
+#include <cstddef>
+#include <ostream>
+
+// What an allocation was made for. The tag is per thread and set by
+// AllocScope; anything outside a scope counts as OTHER.
+enum class AllocTag {
+    OTHER,
+    SPAWN,          // enemies, orbs
+    SHOOT,          // bullets from the player, enemies and turrets
+    STREAMING,      // obstacles of newly loaded chunks
+    SNAPSHOT,       // PublishSnapshot
+    RENDER_TEXT     // TTF surfaces and textures for RenderText
+};
+const int ALLOC_TAG_COUNT = static_cast<int>(AllocTag::RENDER_TEXT) + 1;
+
+struct AllocFrameStats {
+    int allocations[ALLOC_TAG_COUNT];
+    size_t bytes[ALLOC_TAG_COUNT];
+    int totalAllocations;
+    size_t totalBytes;
+};
+
+// Counts heap allocations by tag. Opt-in: only builds with TRACK_ALLOCATIONS
+// defined (the Debug target) replace the global operator new/delete and hook
+// SDL's malloc, so surfaces and other SDL memory are counted too. Without it
+// every call here is free and the stats stay zero.
+//
+// A frame is the time between two EndFrame calls, on every thread. For a
+// "no allocations here" check, compare GetAllocationCount before and after.
+class AllocTracker {
+public:
+    static bool IsEnabled();
+    static void Install();                  // before anything touches SDL
+
+    static AllocFrameStats EndFrame();      // counts since the last EndFrame
+    static Uint64 GetAllocationCount();     // since Install, all tags
+    static const char* GetTagName(AllocTag tag);
+
+    static void PrintSummary(std::ostream& out);   // per-tag totals and the worst frame
+};
+
+#ifdef TRACK_ALLOCATIONS
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag tag);
+    ~AllocScope();
+
+private:
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+    AllocTag previous;
+};
+#else
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag) {}
+};
+#endif
+
+#endif
@@ -1,57 +1,31 @@
 #include "Bullet.h"
-#include "Player.h"
-#include <iostream>
 
-Bullet::Bullet(float x, float y, float vx, float vy, SDL_Texture* selectedTexture, int baseDamage, BulletType type)
-    : x(x), y(y), vx(vx), vy(vy), width(30), height(30), active(true), texture(selectedTexture), type(type)
-    {
-        float damageMultiplier = 1.0f;
-        switch (type) {
-            case BulletType::NORMAL:
-                this->width = 20;
-                this->height = 20;
-                break;
-            case BulletType::POWERED:
-                this->width = 25;
-                this->height = 25;
-                damageMultiplier = 1.5f;
-                break;
-            case BulletType::SUPER_POWERED:
-                this->width = 30;
-                this->height = 30;
-                damageMultiplier = 2.5f;
-                break;
-            case BulletType::EXTREME_POWERED:
-                this->width = 35;
-                this->height = 35;
-                damageMultiplier = 4.0f;
-                break;
-        }
-        damage = static_cast<int>(baseDamage * damageMultiplier);
+int Bullet::SizeOf(BulletType type) {
+    switch (type) {
+        case BulletType::NORMAL:          return 20;
+        case BulletType::POWERED:         return 25;
+        case BulletType::SUPER_POWERED:   return 30;
+        case BulletType::EXTREME_POWERED: return 35;
     }
+    return 30;
+}
 
-
-void Bullet::Update() {
-    float bulletSpeed = BULLET_SPEED;
+float Bullet::DamageMultiplierOf(BulletType type) {
     switch (type) {
-        case BulletType::NORMAL:
-            break;
-        case BulletType::POWERED:
-            bulletSpeed *= 1.5f;
-            break;
-        case BulletType::SUPER_POWERED:
-            bulletSpeed *= 2.0f;
-            break;
-        case BulletType::EXTREME_POWERED:
-            bulletSpeed *= 2.5f;
-            break;
+        case BulletType::NORMAL:          return 1.0f;
+        case BulletType::POWERED:         return 1.5f;
+        case BulletType::SUPER_POWERED:   return 2.5f;
+        case BulletType::EXTREME_POWERED: return 4.0f;
     }
-
-    x += vx * bulletSpeed;
-    y += vy * bulletSpeed;
+    return 1.0f;
 }
 
-void Bullet::Render(SDL_Renderer* renderer, float playerX, float playerY) {
-    SDL_Rect rect = { static_cast<int>(x - playerX + SCREEN_WIDTH / 2), static_cast<int>(y - playerY + SCREEN_HEIGHT / 2), width, height };
-    SDL_RenderCopy(renderer, texture, nullptr, &rect);
+float Bullet::SpeedOf(BulletType type) {
+    switch (type) {
+        case BulletType::NORMAL:          return BULLET_SPEED;
+        case BulletType::POWERED:         return BULLET_SPEED * 1.5f;
+        case BulletType::SUPER_POWERED:   return BULLET_SPEED * 2.0f;
+        case BulletType::EXTREME_POWERED: return BULLET_SPEED * 2.5f;
+    }
+    return BULLET_SPEED;
 }
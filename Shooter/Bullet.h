@@ -1,23 +1,15 @@
 #ifndef BULLET_H
 #define BULLET_H
 
-#include <SDL.h>
 #include "Globals.h"
-#include "Player.h"
 
+// Per-type bullet stats. Bullets themselves are entities in Game::world
+// (PlayerBulletArchetype, EnemyBulletArchetype) or lanes of a pattern volley.
 class Bullet {
 public:
-    float x, y;
-    float vx, vy;
-    int width, height;
-    bool active;
-    SDL_Texture* texture;
-    int damage;
-	BulletType type;
-
-    Bullet(float x, float y, float vx, float vy, SDL_Texture* texture, int damage, BulletType type);
-    void Update();
-    void Render(SDL_Renderer* renderer, float playerX, float playerY);
+    static int SizeOf(BulletType type);
+    static float DamageMultiplierOf(BulletType type);
+    static float SpeedOf(BulletType type);     // pixels per tick for a unit shot direction
 };
 
 #endif
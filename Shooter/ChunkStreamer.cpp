@@ -0,0 +1,257 @@
+#include "ChunkStreamer.h"
+#include "PoissonTiles.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+ChunkStreamer::ChunkStreamer()
+    : seed(0), epoch(0), hasCenter(false), centerX(0), centerY(0), aheadX(0), aheadY(0),
+      generator(nullptr), wakeSignal(nullptr), running(false) {}
+
+ChunkStreamer::~ChunkStreamer() {
+    Stop();
+}
+
+bool ChunkStreamer::Start() {
+    if (running) return true;
+    PoissonTiles::Get();   // build the shared sites now rather than during the first chunk
+
+    wakeSignal = SDL_CreateSemaphore(0);
+    if (!wakeSignal) {
+        std::cerr << "ChunkStreamer: SDL_CreateSemaphore Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    running = true;
+    generator = SDL_CreateThread(GeneratorMain, "ChunkGenerator", this);
+    if (!generator) {
+        std::cerr << "ChunkStreamer: SDL_CreateThread Error: " << SDL_GetError() << std::endl;
+        running = false;
+        SDL_DestroySemaphore(wakeSignal);
+        wakeSignal = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void ChunkStreamer::Stop() {
+    if (!running) return;
+
+    running = false;
+    SDL_SemPost(wakeSignal);
+    SDL_WaitThread(generator, nullptr);
+    generator = nullptr;
+
+    SDL_DestroySemaphore(wakeSignal);
+    wakeSignal = nullptr;
+}
+
+void ChunkStreamer::Reset(Uint32 worldSeed) {
+    seed = worldSeed;
+    epoch++;   // anything still in flight belongs to the old world
+    hasCenter = false;
+    loaded.clear();
+    requested.clear();
+    ready.clear();
+    destroyed.clear();
+}
+
+// Generator thread: only ever touches the two queues and GenerateLayout, which is pure
+int ChunkStreamer::GeneratorMain(void* data) {
+    ChunkStreamer* streamer = static_cast<ChunkStreamer*>(data);
+    while (streamer->running) {
+        SDL_SemWait(streamer->wakeSignal);
+
+        ChunkRequest request;
+        while (streamer->running && streamer->requests.Pop(request)) {
+            ChunkResult result;
+            result.epoch = request.epoch;
+            GenerateLayout(request.seed, request.chunkX, request.chunkY, result.layout);
+            // The main thread drains results every tick, so a full queue clears quickly
+            while (!streamer->results.Push(std::move(result))) {
+                if (!streamer->running) return 0;
+                SDL_Delay(1);
+            }
+        }
+    }
+    return 0;
+}
+
+Sint64 ChunkStreamer::MakeKey(int chunkX, int chunkY) {
+    return (static_cast<Sint64>(chunkX) << 32) | static_cast<Uint32>(chunkY);
+}
+
+int ChunkStreamer::ChunkCoord(float value) {
+    return static_cast<int>(std::floor(value / CHUNK_SIZE));
+}
+
+void ChunkStreamer::MarkDestroyed(Sint64 chunkKey, int index) {
+    destroyed.insert({chunkKey, index});
+}
+
+// splitmix64 finaliser over (seed, x, y), so neighbouring chunks get unrelated streams
+static Uint64 HashChunk(Uint32 worldSeed, int chunkX, int chunkY) {
+    Uint64 h = (static_cast<Uint64>(worldSeed) << 32) ^ (static_cast<Uint64>(static_cast<Uint32>(chunkX)) * 0x9E3779B97F4A7C15ull)
+             ^ (static_cast<Uint64>(static_cast<Uint32>(chunkY)) * 0xC2B2AE3D27D4EB4Full);
+    h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27; h *= 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return h;
+}
+
+void ChunkStreamer::GenerateLayout(Uint32 worldSeed, int chunkX, int chunkY, ChunkLayout& layout) {
+    layout.chunkX = chunkX;
+    layout.chunkY = chunkY;
+    layout.key = MakeKey(chunkX, chunkY);
+    layout.obstacles.clear();
+
+    // Any subset of the blue-noise sites keeps MIN_SEPARATION_DISTANCE, also across chunk borders
+    const std::vector<PoissonPoint>& sites = PoissonTiles::Get().GetTile(chunkX, chunkY);
+    int siteCount = static_cast<int>(sites.size());
+    int count = std::min(CHUNK_OBSTACLE_COUNT, siteCount);
+
+    std::mt19937 rng(static_cast<std::mt19937::result_type>(HashChunk(worldSeed, chunkX, chunkY)));
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    float originX = static_cast<float>(chunkX) * CHUNK_SIZE;
+    float originY = static_cast<float>(chunkY) * CHUNK_SIZE;
+
+    // Floyd's sampling: 'count' distinct sites with one draw each
+    std::vector<int> chosen;
+    chosen.reserve(count);
+    for (int j = siteCount - count; j < siteCount; ++j) {
+        int pick = std::uniform_int_distribution<int>(0, j)(rng);
+        if (std::find(chosen.begin(), chosen.end(), pick) != chosen.end()) pick = j;
+        chosen.push_back(pick);
+    }
+
+    for (int index = 0; index < count; ++index) {
+        const PoissonPoint& site = sites[chosen[index]];
+        float size = 50.0f + percent(rng);
+        ObstacleType type = (percent(rng) < 90) ? ObstacleType::NEUTRAL : ObstacleType::HOSTILE;
+        // Sites are centres; obstacles are placed by their top-left corner
+        layout.obstacles.push_back({originX + site.x - size * 0.5f, originY + site.y - size * 0.5f, size, type, index});
+    }
+}
+
+// Moves finished layouts into the ready cache; returns true if any arrived
+bool ChunkStreamer::CollectResults() {
+    bool arrived = false;
+    ChunkResult result;
+    while (results.Pop(result)) {
+        if (result.epoch != epoch) continue;
+        Sint64 key = result.layout.key;
+        requested.erase(key);
+        if (loaded.count(key)) continue;   // was needed sooner and built inline
+        ready[key] = std::move(result.layout);
+        arrived = true;
+    }
+    return arrived;
+}
+
+void ChunkStreamer::RequestRing(int chunkX, int chunkY, bool& posted) {
+    if (!running) return;
+    for (int dy = -CHUNK_LOAD_RADIUS; dy <= CHUNK_LOAD_RADIUS; ++dy) {
+        for (int dx = -CHUNK_LOAD_RADIUS; dx <= CHUNK_LOAD_RADIUS; ++dx) {
+            Sint64 key = MakeKey(chunkX + dx, chunkY + dy);
+            if (loaded.count(key) || requested.count(key) || ready.count(key)) continue;
+            ChunkRequest request = {chunkX + dx, chunkY + dy, seed, epoch};
+            if (!requests.Push(std::move(request))) return;   // full: the next pass retries
+            requested.insert(key);
+            posted = true;
+        }
+    }
+}
+
+void ChunkStreamer::LoadRing(std::vector<ChunkLayout>& toLoad, bool& posted) {
+    for (int dy = -CHUNK_LOAD_RADIUS; dy <= CHUNK_LOAD_RADIUS; ++dy) {
+        for (int dx = -CHUNK_LOAD_RADIUS; dx <= CHUNK_LOAD_RADIUS; ++dx) {
+            Sint64 key = MakeKey(centerX + dx, centerY + dy);
+            if (loaded.count(key)) continue;
+
+            auto cached = ready.find(key);
+            if (cached != ready.end()) {
+                toLoad.push_back(std::move(cached->second));
+                ready.erase(cached);
+            } else if (!running || (std::abs(dx) <= CHUNK_SYNC_RADIUS && std::abs(dy) <= CHUNK_SYNC_RADIUS)) {
+                // The worker is behind (or missing) and the chunk is about to be seen
+                toLoad.emplace_back();
+                GenerateLayout(seed, centerX + dx, centerY + dy, toLoad.back());
+            } else {
+                if (!requested.count(key)) {
+                    ChunkRequest request = {centerX + dx, centerY + dy, seed, epoch};
+                    if (requests.Push(std::move(request))) {
+                        requested.insert(key);
+                        posted = true;
+                    }
+                }
+                continue;   // loaded once the worker delivers it
+            }
+            loaded.insert(key);
+
+            // Leave out what the player already destroyed here
+            auto& spawns = toLoad.back().obstacles;
+            spawns.erase(std::remove_if(spawns.begin(), spawns.end(), [&](const ObstacleSpawn& spawn) {
+                return destroyed.count({key, spawn.index}) != 0;
+            }), spawns.end());
+        }
+    }
+}
+
+// Drops cached layouts that neither the player nor the prediction is heading for
+void ChunkStreamer::PruneReady() {
+    for (auto it = ready.begin(); it != ready.end();) {
+        int x = it->second.chunkX;
+        int y = it->second.chunkY;
+        bool nearCenter = std::abs(x - centerX) <= CHUNK_UNLOAD_RADIUS && std::abs(y - centerY) <= CHUNK_UNLOAD_RADIUS;
+        bool nearAhead = std::abs(x - aheadX) <= CHUNK_UNLOAD_RADIUS && std::abs(y - aheadY) <= CHUNK_UNLOAD_RADIUS;
+        if (nearCenter || nearAhead) ++it;
+        else it = ready.erase(it);
+    }
+}
+
+bool ChunkStreamer::Update(float playerX, float playerY, float velocityX, float velocityY,
+                           std::vector<ChunkLayout>& toLoad, std::vector<Sint64>& toUnload) {
+    toLoad.clear();
+    toUnload.clear();
+
+    bool arrived = CollectResults();
+
+    int chunkX = ChunkCoord(playerX);
+    int chunkY = ChunkCoord(playerY);
+    int predictedX = ChunkCoord(playerX + velocityX * CHUNK_PREDICT_TICKS);
+    int predictedY = ChunkCoord(playerY + velocityY * CHUNK_PREDICT_TICKS);
+    bool moved = !hasCenter || chunkX != centerX || chunkY != centerY;
+    bool aheadMoved = !hasCenter || predictedX != aheadX || predictedY != aheadY;
+    if (!moved && !aheadMoved && !arrived) return false;
+
+    hasCenter = true;
+    centerX = chunkX;
+    centerY = chunkY;
+    aheadX = predictedX;
+    aheadY = predictedY;
+
+    if (moved) {
+        // --- Unload chunks that fell outside the (wider) unload radius ---
+        for (auto it = loaded.begin(); it != loaded.end();) {
+            int loadedX = static_cast<int>(*it >> 32);
+            int loadedY = static_cast<int>(static_cast<Sint32>(*it & 0xFFFFFFFF));
+            if (std::abs(loadedX - chunkX) > CHUNK_UNLOAD_RADIUS || std::abs(loadedY - chunkY) > CHUNK_UNLOAD_RADIUS) {
+                toUnload.push_back(*it);
+                it = loaded.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    if (moved || aheadMoved) PruneReady();
+
+    // --- Load what is ready around the player, then queue up the predicted ring ---
+    bool posted = false;
+    LoadRing(toLoad, posted);
+    if (aheadMoved) RequestRing(aheadX, aheadY, posted);
+    if (posted) SDL_SemPost(wakeSignal);
+
+    return !toLoad.empty() || !toUnload.empty();
+}
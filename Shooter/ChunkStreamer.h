@@ -0,0 +1,98 @@
+#ifndef CHUNKSTREAMER_H
+#define CHUNKSTREAMER_H
+
+#include <SDL.h>
+#include <atomic>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Globals.h"
+#include "SpscQueue.h"
+
+// One obstacle of a chunk layout, in world coordinates
+struct ObstacleSpawn {
+    float x, y;
+    float size;
+    ObstacleType type;
+    int index;          // position in the chunk's layout, stable across reloads
+};
+
+struct ChunkLayout {
+    int chunkX, chunkY;
+    Sint64 key;
+    std::vector<ObstacleSpawn> obstacles;
+};
+
+struct ChunkRequest {
+    int chunkX, chunkY;
+    Uint32 seed;
+    Uint32 epoch;       // Reset() bumps it so layouts of the previous world are dropped
+};
+
+struct ChunkResult {
+    Uint32 epoch;
+    ChunkLayout layout;
+};
+
+// The infinite world is cut into CHUNK_SIZE squares. Each chunk's obstacle
+// layout is a pure function of (world seed, chunk coords): the seed picks
+// CHUNK_OBSTACLE_COUNT of the chunk's precomputed Poisson-disk sites
+// (PoissonTiles) and rolls their sizes and types, so walking away and
+// coming back rebuilds the same obstacles; ones the player destroyed are
+// remembered and left out. Chunks within CHUNK_LOAD_RADIUS of the player's
+// chunk are loaded, and unloaded again once they are further than
+// CHUNK_UNLOAD_RADIUS.
+//
+// Layouts are generated on a background thread. The streamer looks
+// CHUNK_PREDICT_TICKS ahead along the player's velocity and requests the ring
+// around that point early; requests and finished layouts travel through two
+// lock-free SPSC queues, and finished layouts wait in a cache until the
+// player's ring reaches them. A chunk within CHUNK_SYNC_RADIUS that the worker
+// has not delivered yet is generated inline, so the player never sees a gap.
+class ChunkStreamer {
+public:
+    ChunkStreamer();
+    ~ChunkStreamer();
+
+    bool Start();   // launches the generator thread; without it every layout is built inline
+    void Stop();
+    void Reset(Uint32 worldSeed);
+
+    // Called once per tick (velocity in pixels per tick). Returns false, with
+    // both lists empty, when there is nothing to build or drop this tick.
+    bool Update(float playerX, float playerY, float velocityX, float velocityY,
+                std::vector<ChunkLayout>& toLoad, std::vector<Sint64>& toUnload);
+
+    void MarkDestroyed(Sint64 chunkKey, int index);
+
+    static Sint64 MakeKey(int chunkX, int chunkY);
+    static void GenerateLayout(Uint32 worldSeed, int chunkX, int chunkY, ChunkLayout& layout);
+
+private:
+    static int ChunkCoord(float value);
+    static int GeneratorMain(void* data);
+
+    bool CollectResults();
+    void RequestRing(int chunkX, int chunkY, bool& posted);
+    void LoadRing(std::vector<ChunkLayout>& toLoad, bool& posted);
+    void PruneReady();
+
+    Uint32 seed;
+    Uint32 epoch;
+    bool hasCenter;
+    int centerX, centerY;
+    int aheadX, aheadY;
+    std::unordered_set<Sint64> loaded;
+    std::unordered_set<Sint64> requested;            // sent to the worker, not back yet
+    std::unordered_map<Sint64, ChunkLayout> ready;   // generated ahead, not loaded yet
+    std::set<std::pair<Sint64, int>> destroyed;
+
+    SpscQueue<ChunkRequest, 128> requests;   // main -> generator
+    SpscQueue<ChunkResult, 128> results;     // generator -> main
+    SDL_Thread* generator;
+    SDL_sem* wakeSignal;
+    std::atomic<bool> running;
+};
+
+#endif
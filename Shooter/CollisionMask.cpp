@@ -0,0 +1,227 @@
+#include "CollisionMask.h"
+#include <SDL_image.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static const Uint8 MASK_ALPHA_THRESHOLD = 128;
+
+CollisionMask::CollisionMask() : width(0), height(0), wordsPerRow(0) {}
+
+void CollisionMask::BuildFromAlpha(const std::vector<Uint32>& alphaSums, int sourceWidth, int sourceHeight,
+                                   int maskWidth, int maskHeight, Uint8 alphaThreshold) {
+    width = maskWidth;
+    height = maskHeight;
+    wordsPerRow = (width + 63) / 64;
+    bits.assign(static_cast<size_t>(wordsPerRow) * height, 0);
+
+    const int stride = sourceWidth + 1;
+    for (int y = 0; y < height; ++y) {
+        int y0 = static_cast<int>(static_cast<long long>(y) * sourceHeight / height);
+        int y1 = std::max(y0 + 1, static_cast<int>(static_cast<long long>(y + 1) * sourceHeight / height));
+        for (int x = 0; x < width; ++x) {
+            int x0 = static_cast<int>(static_cast<long long>(x) * sourceWidth / width);
+            int x1 = std::max(x0 + 1, static_cast<int>(static_cast<long long>(x + 1) * sourceWidth / width));
+            Uint32 sum = alphaSums[y1 * stride + x1] - alphaSums[y0 * stride + x1]
+                       - alphaSums[y1 * stride + x0] + alphaSums[y0 * stride + x0];
+            Uint32 area = static_cast<Uint32>((x1 - x0) * (y1 - y0));
+            if (sum >= static_cast<Uint32>(alphaThreshold) * area) {
+                bits[y * wordsPerRow + (x >> 6)] |= Uint64(1) << (x & 63);
+            }
+        }
+    }
+}
+
+void CollisionMask::BuildDisc(int diameter) {
+    width = diameter;
+    height = diameter;
+    wordsPerRow = (width + 63) / 64;
+    bits.assign(static_cast<size_t>(wordsPerRow) * height, 0);
+
+    float radius = diameter * 0.5f;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            float dx = x + 0.5f - radius;
+            float dy = y + 0.5f - radius;
+            if (dx * dx + dy * dy <= radius * radius) {
+                bits[y * wordsPerRow + (x >> 6)] |= Uint64(1) << (x & 63);
+            }
+        }
+    }
+}
+
+Uint64 CollisionMask::Word(int row, int word) const {
+    if (word < 0 || word >= wordsPerRow) return 0;
+    return bits[row * wordsPerRow + word];
+}
+
+bool CollisionMask::Overlaps(const CollisionMask& other, int offsetX, int offsetY) const {
+    int rowStart = std::max(0, offsetY);
+    int rowEnd = std::min(height, offsetY + other.height);
+    int colStart = std::max(0, offsetX);
+    int colEnd = std::min(width, offsetX + other.width);
+    if (rowStart >= rowEnd || colStart >= colEnd) return false;
+
+    int firstWord = colStart >> 6;
+    int lastWord = (colEnd - 1) >> 6;
+    for (int row = rowStart; row < rowEnd; ++row) {
+        int otherRow = row - offsetY;
+        for (int word = firstWord; word <= lastWord; ++word) {
+            // The other mask's 64 columns that line up with this word
+            int otherCol = word * 64 - offsetX;
+            Uint64 aligned;
+            if (otherCol >= 0) {
+                int shift = otherCol & 63;
+                aligned = other.Word(otherRow, otherCol >> 6) >> shift;
+                if (shift) aligned |= other.Word(otherRow, (otherCol >> 6) + 1) << (64 - shift);
+            } else if (otherCol > -64) {
+                aligned = other.Word(otherRow, 0) << -otherCol;
+            } else {
+                continue;
+            }
+            if (Word(row, word) & aligned) return true;
+        }
+    }
+    return false;
+}
+
+int CollisionMask::GetWidth() const {
+    return width;
+}
+
+int CollisionMask::GetHeight() const {
+    return height;
+}
+
+bool MaskTouches(const CollisionMask& probe, float probeX, float probeY,
+                 const CollisionMask& sprite, float centerX, float centerY, float dirX, float dirY) {
+    // Sprite frame: columns along its right (-dirY, dirX), rows against its heading
+    float dx = probeX - centerX;
+    float dy = probeY - centerY;
+    float column = dx * -dirY + dy * dirX + sprite.GetWidth() * 0.5f;
+    float row = -(dx * dirX + dy * dirY) + sprite.GetHeight() * 0.5f;
+    int offsetX = static_cast<int>(std::floor(column - probe.GetWidth() * 0.5f + 0.5f));
+    int offsetY = static_cast<int>(std::floor(row - probe.GetHeight() * 0.5f + 0.5f));
+    return sprite.Overlaps(probe, offsetX, offsetY);
+}
+
+bool SweepMask(const CollisionMask& probe, float fromX, float fromY, float toX, float toY, float startTime,
+               const CollisionMask& sprite, float centerX, float centerY, float dirX, float dirY, float& hitTime) {
+    float deltaX = toX - fromX;
+    float deltaY = toY - fromY;
+    float remaining = std::sqrt(deltaX * deltaX + deltaY * deltaY) * (1.0f - startTime);
+    float step = std::max(1.0f, probe.GetWidth() * 0.5f);
+    int steps = static_cast<int>(std::ceil(remaining / step));
+
+    for (int i = 0; i <= steps; ++i) {
+        float t = (steps > 0) ? startTime + (1.0f - startTime) * i / steps : startTime;
+        if (MaskTouches(probe, fromX + deltaX * t, fromY + deltaY * t, sprite, centerX, centerY, dirX, dirY)) {
+            hitTime = t;
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- Bank ---
+
+static const char* const MASK_SPRITE_PATHS[static_cast<int>(MaskSprite::COUNT)] = {
+    "assets/player1.png",
+    "assets/enemy_normal.png",
+    "assets/enemy_fast.png",
+    "assets/enemy_tank.png",
+    "assets/enemy_quick.png",
+    "assets/enemy_boss.png",
+    "assets/obstacle1.png",
+    "assets/obstacle2.png",
+    "assets/orb.png",
+};
+
+CollisionMaskBank::CollisionMaskBank() : lock(SDL_CreateMutex()) {
+    for (auto& source : sources) {
+        source.width = 0;
+        source.height = 0;
+    }
+}
+
+CollisionMaskBank::~CollisionMaskBank() {
+    Clear();
+    if (lock) SDL_DestroyMutex(lock);
+}
+
+bool CollisionMaskBank::Load() {
+    bool allLoaded = true;
+    for (int i = 0; i < static_cast<int>(MaskSprite::COUNT); ++i) {
+        if (!LoadSource(MASK_SPRITE_PATHS[i], sources[i])) allLoaded = false;
+    }
+    return allLoaded;
+}
+
+bool CollisionMaskBank::LoadSource(const char* path, Source& source) {
+    source.alphaSums.clear();
+
+    SDL_Surface* loaded = IMG_Load(path);
+    if (!loaded) {
+        std::cerr << "CollisionMaskBank: IMG_Load Error (" << path << "): " << IMG_GetError() << std::endl;
+        return false;
+    }
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    if (!surface) {
+        std::cerr << "CollisionMaskBank: SDL_ConvertSurfaceFormat Error (" << path << "): " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    source.width = surface->w;
+    source.height = surface->h;
+    const int stride = source.width + 1;
+    source.alphaSums.assign(static_cast<size_t>(stride) * (source.height + 1), 0);
+
+    SDL_LockSurface(surface);
+    const Uint8* pixels = static_cast<const Uint8*>(surface->pixels);
+    for (int y = 0; y < source.height; ++y) {
+        const Uint8* row = pixels + y * surface->pitch;
+        Uint32 rowSum = 0;
+        for (int x = 0; x < source.width; ++x) {
+            rowSum += row[x * 4 + 3];   // RGBA32: alpha is the fourth byte
+            source.alphaSums[(y + 1) * stride + x + 1] = source.alphaSums[y * stride + x + 1] + rowSum;
+        }
+    }
+    SDL_UnlockSurface(surface);
+    SDL_FreeSurface(surface);
+    return true;
+}
+
+void CollisionMaskBank::Clear() {
+    for (auto& entry : masks) delete entry.second;
+    masks.clear();
+}
+
+const CollisionMask* CollisionMaskBank::Acquire(MaskSprite sprite, int width, int height) {
+    const Source& source = sources[static_cast<int>(sprite)];
+    if (source.alphaSums.empty() || width <= 0 || height <= 0) return nullptr;
+
+    Uint64 key = (Uint64(sprite) << 40) | (Uint64(width) << 20) | Uint64(height);
+    SDL_LockMutex(lock);
+    CollisionMask*& mask = masks[key];
+    if (!mask) {
+        mask = new CollisionMask();
+        mask->BuildFromAlpha(source.alphaSums, source.width, source.height, width, height, MASK_ALPHA_THRESHOLD);
+    }
+    SDL_UnlockMutex(lock);
+    return mask;
+}
+
+const CollisionMask* CollisionMaskBank::AcquireDisc(int diameter) {
+    if (diameter <= 0) return nullptr;
+
+    Uint64 key = (Uint64(MaskSprite::COUNT) << 40) | (Uint64(diameter) << 20) | Uint64(diameter);
+    SDL_LockMutex(lock);
+    CollisionMask*& mask = masks[key];
+    if (!mask) {
+        mask = new CollisionMask();
+        mask->BuildDisc(diameter);
+    }
+    SDL_UnlockMutex(lock);
+    return mask;
+}
@@ -0,0 +1,81 @@
+#ifndef COLLISIONMASK_H
+#define COLLISIONMASK_H
+
+#include <SDL.h>
+#include <map>
+#include <vector>
+
+// One bit per rendered pixel, set where the sprite is opaque. Rows are packed
+// 64 pixels to a Uint64 (bit k of word w is column 64 * w + k), so testing
+// two masks costs one shift and AND per 64 pixels of overlapping row.
+class CollisionMask {
+public:
+    CollisionMask();
+
+    // Box-filters a sprite's alpha down (or up) to width x height; a pixel is
+    // set when the average alpha of its footprint reaches alphaThreshold.
+    // alphaSums is the summed-area table of the alpha channel,
+    // (sourceWidth + 1) x (sourceHeight + 1), so each pixel costs four reads.
+    void BuildFromAlpha(const std::vector<Uint32>& alphaSums, int sourceWidth, int sourceHeight,
+                        int width, int height, Uint8 alphaThreshold);
+    void BuildDisc(int diameter);
+
+    // True if a set pixel of 'other', placed with its top-left corner at
+    // (offsetX, offsetY) in this mask's pixels, lands on a set pixel here
+    bool Overlaps(const CollisionMask& other, int offsetX, int offsetY) const;
+
+    int GetWidth() const;
+    int GetHeight() const;
+
+private:
+    Uint64 Word(int row, int word) const;
+
+    int width, height;
+    int wordsPerRow;
+    std::vector<Uint64> bits;
+};
+
+// Does 'probe' (an unrotated round sprite, e.g. a bullet) centred at
+// (probeX, probeY) touch 'sprite', drawn centred at (centerX, centerY) and
+// turned to the heading (dirX, dirY)? The probe centre is taken into the
+// sprite's frame; the probe itself is not rotated, which is exact for discs.
+bool MaskTouches(const CollisionMask& probe, float probeX, float probeY,
+                 const CollisionMask& sprite, float centerX, float centerY, float dirX, float dirY);
+
+// MaskTouches at steps of at most half the probe size from startTime to the
+// end of the path (fromX, fromY) -> (toX, toY); hitTime is the first touch.
+bool SweepMask(const CollisionMask& probe, float fromX, float fromY, float toX, float toY, float startTime,
+               const CollisionMask& sprite, float centerX, float centerY, float dirX, float dirY, float& hitTime);
+
+enum class MaskSprite { PLAYER, ENEMY_NORMAL, ENEMY_FAST, ENEMY_TANK, ENEMY_QUICK, ENEMY_BOSS,
+                        OBSTACLE_NEUTRAL, OBSTACLE_HOSTILE, ORB, COUNT };
+
+// Sprite alpha channels, read once at startup, and the masks made from them
+// at each rendered size in use. Masks are built on first request and live
+// until Clear, so entities keep a plain pointer to theirs. A sprite that
+// failed to load yields nullptr and callers fall back to the shape test.
+class CollisionMaskBank {
+public:
+    CollisionMaskBank();
+    ~CollisionMaskBank();
+
+    bool Load();   // needs IMG_Init; any thread
+    void Clear();
+
+    const CollisionMask* Acquire(MaskSprite sprite, int width, int height);
+    const CollisionMask* AcquireDisc(int diameter);
+
+private:
+    struct Source {
+        int width, height;
+        std::vector<Uint32> alphaSums;   // summed-area table, empty if the sprite failed to load
+    };
+
+    bool LoadSource(const char* path, Source& source);
+
+    Source sources[static_cast<int>(MaskSprite::COUNT)];
+    std::map<Uint64, CollisionMask*> masks;   // key: sprite, width, height
+    SDL_mutex* lock;                          // Acquire can come from job threads
+};
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef COLLISIONSHAPES_H
+#define COLLISIONSHAPES_H
+
+#include <cmath>
+
+// Collision shapes in world space, all float. Round things (bullets, orbs,
+// the player, most enemies) are circles; rotating obstacles and the boss are
+// oriented boxes that follow their heading. The tests are inline and
+// branch-light so the bullet loops do not pay for SDL_Rect conversions and
+// SDL_HasIntersection calls. Touching shapes do not overlap.
+
+struct Circle {
+    float x, y;             // centre
+    float radius;
+};
+
+struct Obb {
+    float x, y;             // centre
+    float axisX, axisY;     // unit "right" axis; "up" is (axisY, -axisX)
+    float halfW, halfH;     // half extents along right and up
+};
+
+enum class ShapeType { CIRCLE, OBB };
+
+// An entity whose shape depends on its type (see Enemy::GetShape)
+struct CollisionShape {
+    ShapeType type;
+    union {
+        Circle circle;
+        Obb box;
+    };
+
+    CollisionShape(const Circle& c) : type(ShapeType::CIRCLE), circle(c) {}
+    CollisionShape(const Obb& b) : type(ShapeType::OBB), box(b) {}
+};
+
+// Box with its up axis along a heading, as sprites are drawn (Orientation.h)
+inline Obb MakeObb(float centerX, float centerY, float width, float height, float dirX, float dirY) {
+    return {centerX, centerY, -dirY, dirX, width * 0.5f, height * 0.5f};
+}
+
+// World point into the box's frame (x along right, y along up)
+inline void ToObbLocal(const Obb& box, float worldX, float worldY, float& localX, float& localY) {
+    float dx = worldX - box.x;
+    float dy = worldY - box.y;
+    localX = dx * box.axisX + dy * box.axisY;
+    localY = dx * box.axisY - dy * box.axisX;
+}
+
+// --- Narrowphase: one specialisation per shape pair ---
+template <typename A, typename B>
+struct Narrowphase;
+
+template <>
+struct Narrowphase<Circle, Circle> {
+    static bool Overlap(const Circle& a, const Circle& b) {
+        float dx = b.x - a.x;
+        float dy = b.y - a.y;
+        float reach = a.radius + b.radius;
+        return dx * dx + dy * dy < reach * reach;
+    }
+};
+
+template <>
+struct Narrowphase<Circle, Obb> {
+    static bool Overlap(const Circle& a, const Obb& b) {
+        float localX, localY;
+        ToObbLocal(b, a.x, a.y, localX, localY);
+        // Distance from the centre to the closest point of the box
+        float outX = std::fabs(localX) - b.halfW;
+        float outY = std::fabs(localY) - b.halfH;
+        outX = outX > 0.0f ? outX : 0.0f;
+        outY = outY > 0.0f ? outY : 0.0f;
+        return outX * outX + outY * outY < a.radius * a.radius;
+    }
+};
+
+template <>
+struct Narrowphase<Obb, Circle> {
+    static bool Overlap(const Obb& a, const Circle& b) {
+        return Narrowphase<Circle, Obb>::Overlap(b, a);
+    }
+};
+
+template <>
+struct Narrowphase<Obb, Obb> {
+    // Separating axis test on the four face normals
+    static bool Overlap(const Obb& a, const Obb& b) {
+        float dx = b.x - a.x;
+        float dy = b.y - a.y;
+        const float axes[4][2] = {{a.axisX, a.axisY}, {a.axisY, -a.axisX}, {b.axisX, b.axisY}, {b.axisY, -b.axisX}};
+        for (const auto& axis : axes) {
+            float reachA = a.halfW * std::fabs(a.axisX * axis[0] + a.axisY * axis[1]) +
+                           a.halfH * std::fabs(a.axisY * axis[0] - a.axisX * axis[1]);
+            float reachB = b.halfW * std::fabs(b.axisX * axis[0] + b.axisY * axis[1]) +
+                           b.halfH * std::fabs(b.axisY * axis[0] - b.axisX * axis[1]);
+            if (std::fabs(dx * axis[0] + dy * axis[1]) >= reachA + reachB) return false;
+        }
+        return true;
+    }
+};
+
+// A runtime shape on either side costs one switch, then the static test runs
+template <typename B>
+struct Narrowphase<CollisionShape, B> {
+    static bool Overlap(const CollisionShape& a, const B& b) {
+        if (a.type == ShapeType::CIRCLE) return Narrowphase<Circle, B>::Overlap(a.circle, b);
+        return Narrowphase<Obb, B>::Overlap(a.box, b);
+    }
+};
+
+template <typename A>
+struct Narrowphase<A, CollisionShape> {
+    static bool Overlap(const A& a, const CollisionShape& b) {
+        if (b.type == ShapeType::CIRCLE) return Narrowphase<A, Circle>::Overlap(a, b.circle);
+        return Narrowphase<A, Obb>::Overlap(a, b.box);
+    }
+};
+
+template <>
+struct Narrowphase<CollisionShape, CollisionShape> {
+    static bool Overlap(const CollisionShape& a, const CollisionShape& b) {
+        if (a.type == ShapeType::CIRCLE) return Narrowphase<Circle, CollisionShape>::Overlap(a.circle, b);
+        return Narrowphase<Obb, CollisionShape>::Overlap(a.box, b);
+    }
+};
+
+template <typename A, typename B>
+inline bool Overlaps(const A& a, const B& b) {
+    return Narrowphase<A, B>::Overlap(a, b);
+}
+
+// Smallest move (pushX, pushY) that takes the circle out of the box; false if they do not overlap
+inline bool PushOut(const Circle& circle, const Obb& box, float& pushX, float& pushY) {
+    float localX, localY;
+    ToObbLocal(box, circle.x, circle.y, localX, localY);
+
+    float closestX = std::fmax(-box.halfW, std::fmin(localX, box.halfW));
+    float closestY = std::fmax(-box.halfH, std::fmin(localY, box.halfH));
+    float awayX = localX - closestX;
+    float awayY = localY - closestY;
+    float distSq = awayX * awayX + awayY * awayY;
+    if (distSq >= circle.radius * circle.radius) return false;
+
+    float moveX, moveY;   // in the box's frame
+    if (distSq > 0.0f) {
+        // Centre outside the box: straight away from the closest point
+        float dist = std::sqrt(distSq);
+        float depth = circle.radius - dist;
+        moveX = awayX / dist * depth;
+        moveY = awayY / dist * depth;
+    } else {
+        // Centre inside: out through the nearest face
+        float exitX = box.halfW - std::fabs(localX) + circle.radius;
+        float exitY = box.halfH - std::fabs(localY) + circle.radius;
+        if (exitX < exitY) {
+            moveX = localX < 0.0f ? -exitX : exitX;
+            moveY = 0.0f;
+        } else {
+            moveX = 0.0f;
+            moveY = localY < 0.0f ? -exitY : exitY;
+        }
+    }
+    pushX = moveX * box.axisX + moveY * box.axisY;
+    pushY = moveX * box.axisY - moveY * box.axisX;
+    return true;
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef ECS_H
+#define ECS_H
+
+#include <SDL.h>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+struct CollisionMask;
+
+// --- Components ---
+// Plain data, one array per component per archetype. Systems are plain loops
+// in Game over World::Each.
+struct Position {
+    float x, y;                 // sprite centre, world space
+};
+
+struct PrevPosition {
+    float x, y;                 // Position before this tick's move, for swept collision
+};
+
+struct Velocity {
+    float x, y;                 // pixels per tick
+};
+
+struct Appearance {
+    SDL_Texture* texture;
+    int width, height;
+    float alpha;                // 0-255
+};
+
+struct Fade {
+    float rate;                 // alpha lost per tick; the entity goes at 0
+};
+
+struct Pickup {
+    int xp;
+    const CollisionMask* mask;  // sprite pixels at this size, null if unavailable
+};
+
+struct Damage {
+    int amount;                 // taken by whatever the entity hits first
+};
+
+// Tags: no data, they only keep the player's and the enemies' bullets in
+// separate archetypes so each bullet phase visits its own
+struct PlayerShot {};
+struct EnemyShot {};
+
+// Every entity with the same set of components lives in one Archetype, as
+// one contiguous column per component. Rows are removed by swapping the last
+// row into the hole, so nothing may keep a row index across a removal.
+template <typename... Components>
+class Archetype {
+public:
+    template <typename C>
+    static constexpr bool Has() { return (std::is_same<C, Components>::value || ...); }
+
+    int Create(const Components&... values) {
+        (std::get<std::vector<Components>>(columns).push_back(values), ...);
+        return count++;
+    }
+
+    void Destroy(int row) {
+        int last = count - 1;
+        if (row < 0 || row > last) return;
+        ((std::get<std::vector<Components>>(columns)[row] = std::get<std::vector<Components>>(columns)[last]), ...);
+        (std::get<std::vector<Components>>(columns).pop_back(), ...);
+        count--;
+    }
+
+    void Clear() {
+        (std::get<std::vector<Components>>(columns).clear(), ...);
+        count = 0;
+    }
+
+    // Destroys every row 'dead' returns true for, called with the row's components
+    template <typename... Wanted, typename Predicate>
+    void DestroyIf(Predicate dead) {
+        for (int row = count - 1; row >= 0; --row) {
+            if (dead(Column<Wanted>()[row]...)) Destroy(row);
+        }
+    }
+
+    template <typename C>
+    std::vector<C>& Column() { return std::get<std::vector<C>>(columns); }
+    template <typename C>
+    const std::vector<C>& Column() const { return std::get<std::vector<C>>(columns); }
+
+    template <typename... Wanted, typename Function>
+    void Each(Function function) {
+        for (int row = 0; row < count; ++row) function(Column<Wanted>()[row]...);
+    }
+
+    int GetCount() const { return count; }
+
+private:
+    std::tuple<std::vector<Components>...> columns;
+    int count = 0;
+};
+
+// The fixed set of archetypes the game uses. Each<Wanted...> visits every
+// archetype that has all the wanted components, so a system written once runs
+// over all matching entities without knowing their kinds.
+template <typename... Archetypes>
+class World {
+public:
+    template <typename A>
+    A& Get() { return std::get<A>(archetypes); }
+    template <typename A>
+    const A& Get() const { return std::get<A>(archetypes); }
+
+    template <typename... Wanted, typename Function>
+    void Each(Function function) {
+        (EachIn<Wanted...>(std::get<Archetypes>(archetypes), function), ...);
+    }
+
+    void Clear() {
+        (std::get<Archetypes>(archetypes).Clear(), ...);
+    }
+
+private:
+    template <typename... Wanted, typename A, typename Function>
+    static void EachIn(A& archetype, Function& function) {
+        if constexpr ((A::template Has<Wanted>() && ...)) archetype.template Each<Wanted...>(function);
+    }
+
+    std::tuple<Archetypes...> archetypes;
+};
+
+// --- The game's archetypes ---
+typedef Archetype<Position, Appearance, Fade, Pickup> OrbArchetype;     // XP orbs dropped by enemies
+typedef Archetype<Position, PrevPosition, Velocity, Appearance, Damage, PlayerShot> PlayerBulletArchetype;
+typedef Archetype<Position, PrevPosition, Velocity, Appearance, Damage, EnemyShot> EnemyBulletArchetype;   // enemies and turrets
+
+typedef World<OrbArchetype, PlayerBulletArchetype, EnemyBulletArchetype> GameWorld;
+
+#endif
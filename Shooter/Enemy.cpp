@@ -2,12 +2,31 @@
 #include "Player.h"
 #include "Obstacle.h"
 #include "Game.h"
+#include "EnemyStore.h"
+#include "RenderSnapshot.h"
+#include "FastMath.h"
+#include "AllocTracker.h"
 #include <iostream>
 
-Enemy::Enemy(float x, float y, SDL_Texture* selectedTexture, Player* target_in, int health_in, float speedFactor, float firingRateFactor_in, Game* game_ptr, EnemyType type_in, SDL_Texture* selectedBulletTexture)
-    : x(x), y(y), vx(0), vy(0), angle(0), width(110), height(110), texture(selectedTexture),bulletTexture(selectedBulletTexture), target(target_in), game(game_ptr), health(health_in), speed(ENEMY_SPEED),
-      firingRateFactor(firingRateFactor_in), lastShotTime(0), state(EnemyState::WANDERING), lastStateChange(0), type(type_in)
+static unsigned int nextLodPhase = 0;
+
+// Timer callback that raises 'flag' on the enemy, if it still exists when the
+// timer fires. Holding the handle instead of 'this' keeps a missed Cancel
+// harmless, and the enemy's store slot may move in the meantime.
+static TimerCallback WakeTimer(EnemyStore* store, EntityHandle handle, bool Enemy::* flag) {
+    return [store, handle, flag]() {
+        if (Enemy* enemy = store->Find(handle)) enemy->*flag = true;
+    };
+}
+
+Enemy::Enemy(float x, float y, SDL_Texture* selectedTexture, int health_in, float speedFactor, float firingRateFactor_in, Game* game_ptr, EnemyType type_in, SDL_Texture* selectedBulletTexture)
+    : store(&game_ptr->enemyStore), slot(-1), typeSlot(-1), width(110), height(110), health(health_in),
+      firingRateFactor(firingRateFactor_in), lastShotTime(0), game(game_ptr),
+      type(type_in), state(EnemyState::WANDERING), lastStateChange(0), wanderDirX(1.0f), wanderDirY(0.0f), circlingDirection(1.0f), distanceToPlayer(0.0f), lodPhase(nextLodPhase++),
+      stateDue(true), shotReady(true), clearShot(false), mask(nullptr), patternIndex(0), weapon(nullptr),
+      texture(selectedTexture), bulletTexture(selectedBulletTexture)
 {
+    float speed = ENEMY_SPEED;
     switch (type) {
         case EnemyType::NORMAL:
             this->health = 150;
@@ -15,34 +34,87 @@ Enemy::Enemy(float x, float y, SDL_Texture* selectedTexture, Player* target_in,
         case EnemyType::FAST:
             this->width = 110;
             this->height = 110;
-            this->speed = ENEMY_SPEED * 1.5f;
+            speed = ENEMY_SPEED * 1.5f;
             this->health = 200;
             break;
         case EnemyType::TANK:
             this->width = 170;
             this->height = 170;
-            this->speed = ENEMY_SPEED * 0.6f;
+            speed = ENEMY_SPEED * 0.6f;
             this->health = 1000;
             this->firingRateFactor *= 0.5f;
             break;
         case EnemyType::QUICK:
              this->width = 130;
              this->height = 130;
-             this->speed = ENEMY_SPEED * 1.2f;
+             speed = ENEMY_SPEED * 1.2f;
              this->health = 400;
              this->firingRateFactor *= 2.0f;
             break;
         case EnemyType::BOSS:
              this->width = 300;
              this->height = 300;
-             this->speed = ENEMY_SPEED * 0.5f;
+             speed = ENEMY_SPEED * 0.5f;
              this->health = 10000;
              this->firingRateFactor *= 1.0f;
              break;
     }
+
+    slot = store->Add(this, x, y, speed, width / 2.0f);
+    game->enemyRegistry.Add(this);
+
+    MaskSprite sprite = MaskSprite::ENEMY_NORMAL;
+    switch (type) {
+        case EnemyType::NORMAL: sprite = MaskSprite::ENEMY_NORMAL; break;
+        case EnemyType::FAST:   sprite = MaskSprite::ENEMY_FAST;   break;
+        case EnemyType::TANK:   sprite = MaskSprite::ENEMY_TANK;   break;
+        case EnemyType::QUICK:  sprite = MaskSprite::ENEMY_QUICK;  break;
+        case EnemyType::BOSS:   sprite = MaskSprite::ENEMY_BOSS;   break;
+    }
+    mask = game->collisionMasks.Acquire(sprite, width, height);
+    weapon = game->weapons.ForEnemy(type);
 }
 
-void Enemy::Update(std::vector<Enemy*>& enemies, std::vector<Obstacle*>& obstacles, std::vector<Bullet*>& enemyBullets, Player* player, Game* game) {
+Enemy::~Enemy() {
+    game->timerWheel.Cancel(stateTimer);
+    game->timerWheel.Cancel(shotTimer);
+    store->Remove(slot);
+    game->enemyRegistry.Remove(this);
+}
+
+float Enemy::GetX() const {
+    return store->x[slot];
+}
+
+float Enemy::GetY() const {
+    return store->y[slot];
+}
+
+SDL_Rect Enemy::GetRect() const {
+    return { static_cast<int>(store->x[slot]), static_cast<int>(store->y[slot]), width, height };
+}
+
+// The boss sprite is boxy and gets a box that turns with it; the rest are round
+EntityHandle Enemy::GetHandle() const {
+    return store->handles[slot];
+}
+
+CollisionShape Enemy::GetShape() const {
+    float radius = store->radius[slot];
+    float centerX = store->x[slot] + width / 2.0f;
+    float centerY = store->y[slot] + height / 2.0f;
+    if (type == EnemyType::BOSS) {
+        return MakeObb(centerX, centerY, static_cast<float>(width), static_cast<float>(height), store->dirX[slot], store->dirY[slot]);
+    }
+    return Circle{centerX, centerY, radius};
+}
+
+// Picks this frame's target velocity. Integrating it into the actual
+// velocity happens for all enemies at once in SteerEnemies.
+void Enemy::Think(Player* player, Uint32 currentTime) {
+    float x = store->x[slot];
+    float y = store->y[slot];
+    float speed = store->speed[slot];
 
     // --- Existing code for calculating distanceToPlayer, etc. ---
     float targetX = player->x;
@@ -50,13 +122,18 @@ void Enemy::Update(std::vector<Enemy*>& enemies, std::vector<Obstacle*>& obstacl
 
     float dxToPlayer = targetX - x;
     float dyToPlayer = targetY - y;
-    float distanceToPlayer = sqrt(dxToPlayer * dxToPlayer + dyToPlayer * dyToPlayer);
+    distanceToPlayer = sqrt(dxToPlayer * dxToPlayer + dyToPlayer * dyToPlayer);
+    float toPlayerX = 1.0f, toPlayerY = 0.0f;
+    if (distanceToPlayer > 0.0f) {
+        toPlayerX = dxToPlayer / distanceToPlayer;
+        toPlayerY = dyToPlayer / distanceToPlayer;
+    }
 
     // --- State Management (Modified) ---
-    Uint32 currentTime = SDL_GetTicks();
-
-    // --- State Transitions
-    if (currentTime - lastStateChange > 3000) {
+    // --- State Transitions (only once the state timer has fired)
+    bool stateTimerFired = stateDue;
+    stateDue = false;
+    if (stateTimerFired && currentTime - lastStateChange > 3000) {
         if (distanceToPlayer < 200.0f && state != EnemyState::RETREATING) {
             state = EnemyState::RETREATING;
             lastStateChange = currentTime;
@@ -71,40 +148,52 @@ void Enemy::Update(std::vector<Enemy*>& enemies, std::vector<Obstacle*>& obstacl
 
     // --- Movement and Behavior based on State ---
     float targetVX = 0, targetVY = 0;
-    float maxForce = 0.3f;
 
     switch (state) {
         case EnemyState::WANDERING: {
-            if (currentTime - lastStateChange > 5000) {
-                wanderingAngle = game->RandomFloat(0, 2 * M_PI);
+            if (stateTimerFired && currentTime - lastStateChange > 5000) {
+                FastSinCos(game->RandomFloat(0, 2 * M_PI), wanderDirY, wanderDirX);
                 lastStateChange = currentTime;
             }
-            targetVX = cos(wanderingAngle) * speed;
-            targetVY = sin(wanderingAngle) * speed;
+            targetVX = wanderDirX * speed;
+            targetVY = wanderDirY * speed;
             break;
         }
         case EnemyState::ENGAGING: {
-            float angleToPlayer = atan2(dyToPlayer, dxToPlayer);
-            targetVX = cos(angleToPlayer) * speed;
-            targetVY = sin(angleToPlayer) * speed;
+            // Follow the shared flow field around obstacles; seek straight when it has no answer
+            float flowX = toPlayerX, flowY = toPlayerY;
+            game->flowField.Sample(x + width / 2.0f, y + height / 2.0f, flowX, flowY);
+            targetVX = flowX * speed;
+            targetVY = flowY * speed;
             break;
         }
         case EnemyState::RETREATING: {
-            float retreatAngle = atan2(dyToPlayer, dxToPlayer) + M_PI;
-            // Add some randomness to the retreat angle for less predictable movement
-            retreatAngle += game->RandomFloat(-M_PI / 4, M_PI / 4);
-            targetVX = cos(retreatAngle) * speed * 1.5f;
-            targetVY = sin(retreatAngle) * speed * 1.5f;
+            // Away from the player, turned by a random amount for less predictable movement
+            Rotor jitter;
+            FastSinCos(game->RandomFloat(-M_PI / 4, M_PI / 4), jitter.s, jitter.c);
+            float retreatX, retreatY;
+            RotatedDirection(-toPlayerX, -toPlayerY, jitter, retreatX, retreatY);
+            targetVX = retreatX * speed * 1.5f;
+            targetVY = retreatY * speed * 1.5f;
             break;
         }
         case EnemyState::CIRCLING: {
-             float angleToPlayer = atan2(dyToPlayer, dxToPlayer);
-            float strafeAngle = angleToPlayer + M_PI / 2.0f;
+            // No clear shot: take the flow field around whatever is in the way
+            float flowX, flowY;
+            if (!clearShot && game->flowField.Sample(x + width / 2.0f, y + height / 2.0f, flowX, flowY)) {
+                targetVX = flowX * speed;
+                targetVY = flowY * speed;
+                break;
+            }
+
+            // Strafe direction is the player direction turned by +90 degrees
+            float strafeX = -toPlayerY;
+            float strafeY = toPlayerX;
 
             // 2. Randomly choose to strafe left or right.
-            if (currentTime - lastStateChange > 2000)
+            if (stateTimerFired && currentTime - lastStateChange > 2000)
 			{
-                circlingDirection = (rand() % 2 == 0) ? 1.0f : -1.0f;
+                circlingDirection = (game->RandomInt(2) == 0) ? 1.0f : -1.0f;
                 lastStateChange = currentTime;
             }
 
@@ -113,22 +202,46 @@ void Enemy::Update(std::vector<Enemy*>& enemies, std::vector<Obstacle*>& obstacl
             float distanceDifference = distanceToPlayer - desiredDistance;
 			float forwardSpeed = std::clamp(distanceDifference * 0.02f, -speed, speed);
 
-            targetVX = cos(angleToPlayer) * forwardSpeed + cos(strafeAngle) * speed * circlingDirection;
-            targetVY = sin(angleToPlayer) * forwardSpeed + sin(strafeAngle) * speed * circlingDirection;
+            targetVX = toPlayerX * forwardSpeed + strafeX * speed * circlingDirection;
+            targetVY = toPlayerY * forwardSpeed + strafeY * speed * circlingDirection;
             break;
         }
     }
 
-    // --- Apply Accumulated Forces (Smoothly) ---
-    vx += std::clamp(targetVX - vx, -maxForce, maxForce);
-    vy += std::clamp(targetVY - vy, -maxForce, maxForce);
+    store->targetVX[slot] = targetVX;
+    store->targetVY[slot] = targetVY;
 
-    // --- Limit Speed ---
-    float currentSpeed = sqrt(vx * vx + vy * vy);
-    if (currentSpeed > speed) {
-        vx = (vx / currentSpeed) * speed;
-        vy = (vy / currentSpeed) * speed;
-    }
+    if (stateTimerFired) ScheduleStateTimer(currentTime);
+}
+
+// Next point where Think has something to decide: circling re-picks its strafe
+// side after 2 s, any other state may switch after 3 s. If that point has
+// already passed without a change (distance did not call for one), look again
+// after ENEMY_STATE_RECHECK_INTERVAL.
+void Enemy::ScheduleStateTimer(Uint32 currentTime) {
+    Uint32 period = (state == EnemyState::CIRCLING) ? 2000 : 3000;
+    Uint32 due = lastStateChange + period + 1;
+    if (static_cast<Sint32>(due - currentTime) <= 0) due = currentTime + ENEMY_STATE_RECHECK_INTERVAL;
+    stateTimer = game->timerWheel.Schedule(due, WakeTimer(store, GetHandle(), &Enemy::stateDue));
+}
+
+// --- AI LOD: skipped ticks keep the last velocity ---
+void Enemy::HoldCourse() {
+    store->targetVX[slot] = store->vx[slot];
+    store->targetVY[slot] = store->vy[slot];
+}
+
+void Enemy::Coast() {
+    store->x[slot] += store->vx[slot];
+    store->y[slot] += store->vy[slot];
+}
+
+// Runs after SteerEnemies has updated the velocity
+void Enemy::Move(std::vector<Obstacle*>& obstacles, Uint32 currentTime) {
+    float& x = store->x[slot];
+    float& y = store->y[slot];
+    float& vx = store->vx[slot];
+    float& vy = store->vy[slot];
 
     // --- Obstacle Avoidance (Robust Push-Back) ---
     SDL_Rect futureRect = {static_cast<int>(x + vx), static_cast<int>(y + vy), width, height};
@@ -183,127 +296,78 @@ void Enemy::Update(std::vector<Enemy*>& enemies, std::vector<Obstacle*>& obstacl
         }
     }
 
-    if (vx != 0 || vy != 0) {  // Only update angle if moving
-        float targetAngle = atan2(vy, vx) * 180.0f / M_PI;
-
-        // Calculate the difference, handling wrap-around
-        float angleDiff = targetAngle - angle;
-        while (angleDiff > 180.0f) angleDiff -= 360.0f;
-        while (angleDiff < -180.0f) angleDiff += 360.0f;
-
-        // Smoothly interpolate towards the target angle
+    float headingX = vx, headingY = vy;
+    if (NormalizeDirection(headingX, headingY)) {  // Only update facing if moving
+        // Smoothly turn towards the direction of travel
         const float rotationSpeed = 0.2f;
-        angle += angleDiff * rotationSpeed;
+        TurnToward(store->dirX[slot], store->dirY[slot], headingX, headingY, rotationSpeed);
+    }
 
-        // -180 to 180
-        while (angle > 180.0f) angle -= 360.0f;
-        while (angle < -180.0f) angle += 360.0f;
+    // Shooting
+    if (shotReady && clearShot && WantsToShoot()) {
+        Shoot();
+        lastShotTime = currentTime;
 
+        Uint32 shotCooldown = static_cast<Uint32>((weapon ? weapon->cooldown : BASE_SHOT_COOLDOWN) / firingRateFactor);
+        shotReady = false;
+        shotTimer = game->timerWheel.Schedule(currentTime + shotCooldown + 1, WakeTimer(store, GetHandle(), &Enemy::shotReady));
     }
+}
 
-    // Shooting
+bool Enemy::WantsToShoot() const {
     float shootingRangeSq = 500.0f * 500.0f;
-    if ((state == EnemyState::ENGAGING || state == EnemyState::CIRCLING) && distanceToPlayer < shootingRangeSq) {
-        Uint32 shotCooldown = static_cast<Uint32>(BASE_SHOT_COOLDOWN / firingRateFactor);
-        if (currentTime - lastShotTime > shotCooldown) {
-            Shoot(enemyBullets);
-            lastShotTime = currentTime;
-        }
-    }
+    return (state == EnemyState::ENGAGING || state == EnemyState::CIRCLING) && distanceToPlayer < shootingRangeSq;
 }
 
-void Enemy::Shoot(std::vector<Bullet*>& enemyBullets) {
+void Enemy::Shoot() {
+    AllocScope allocScope(AllocTag::SHOOT);
+    const Player* target = game->player;
+    if (!target) return;
+
     float targetCenterX = target->x + target->width / 2.0f;
     float targetCenterY = target->y + target->height / 2.0f;
-    float startX = x + width / 2.0f;
-    float startY = y + height / 2.0f;
+    float startX = store->x[slot] + width / 2.0f;
+    float startY = store->y[slot] + height / 2.0f;
 
     float dx = targetCenterX - startX;
     float dy = targetCenterY - startY;
     float length = sqrt(dx * dx + dy * dy);
 
     float baseVX = 0, baseVY = 0;
-    float angleToTargetRad = 0;
     if (length > 0.01f) {
         baseVX = dx / length;
         baseVY = dy / length;
-        angleToTargetRad = atan2(baseVY, baseVX);
     } else {
-        angleToTargetRad = (this->angle + 90.0f) * M_PI / 180.0f;
-        baseVX = cos(angleToTargetRad);
-        baseVY = sin(angleToTargetRad);
+        // Facing turned by 90 degrees
+        baseVX = -store->dirY[slot];
+        baseVY = store->dirX[slot];
     }
 
-    BulletType bulletType = BulletType::NORMAL;
-    int baseDamage = 10;
     bool Shooted = false;
-    switch (type) {
-        case EnemyType::NORMAL:
-            bulletType = BulletType::NORMAL;
-            break;
-        case EnemyType::FAST:
-            bulletType = BulletType::POWERED;
-            break;
-        case EnemyType::TANK:
-            bulletType = BulletType::EXTREME_POWERED;
-            break;
-        case EnemyType::QUICK:
-            bulletType = BulletType::SUPER_POWERED;
-            break;
-        case EnemyType::BOSS:
-            bulletType = BulletType::EXTREME_POWERED;
-            break;
-    }
-
-    switch (type) {
-            case EnemyType::NORMAL:
-            case EnemyType::FAST:
-            case EnemyType::TANK:
-            {
-                enemyBullets.push_back(new Bullet(startX, startY, baseVX, baseVY, this->bulletTexture, baseDamage, bulletType));
-            Shooted = true;
-            }
-            break;
-
-        case EnemyType::QUICK:
-            {
-            float perpAngle = angleToTargetRad + M_PI / 2.0f;
-            float offsetDist = 10.0f;
-            float offsetX = offsetDist * cos(perpAngle);
-            float offsetY = offsetDist * sin(perpAngle);
-
-            enemyBullets.push_back(new Bullet(startX + offsetX, startY + offsetY, baseVX, baseVY, this->bulletTexture, baseDamage, bulletType));
-            enemyBullets.push_back(new Bullet(startX - offsetX, startY - offsetY, baseVX, baseVY, this->bulletTexture, baseDamage, bulletType));
-            Shooted = true;
-            }
-            break;
-
-        case EnemyType::BOSS:
-            {
-            enemyBullets.push_back(new Bullet(startX, startY, baseVX, baseVY, this->bulletTexture, baseDamage, bulletType));
-
-            float angleLeft90 = angleToTargetRad - M_PI / 2.0f;
-            float angleRight90 = angleToTargetRad + M_PI / 2.0f;
-
-            enemyBullets.push_back(new Bullet(startX, startY, cos(angleLeft90), sin(angleLeft90), this->bulletTexture, baseDamage, bulletType));
-            enemyBullets.push_back(new Bullet(startX, startY, cos(angleRight90), sin(angleRight90), this->bulletTexture, baseDamage, bulletType));
-
-            float spreadRad = 15.0f * M_PI / 180.0f;
-            float angleLeftSpread = angleToTargetRad - spreadRad;
-            float angleRightSpread = angleToTargetRad + spreadRad;
-
-            enemyBullets.push_back(new Bullet(startX, startY, cos(angleLeftSpread), sin(angleLeftSpread), this->bulletTexture, baseDamage, bulletType));
-            enemyBullets.push_back(new Bullet(startX, startY, cos(angleRightSpread), sin(angleRightSpread), this->bulletTexture, baseDamage, bulletType));
+    if (weapon && !weapon->patterns.empty()) {
+        // One analytic volley instead of a bullet entity per shot (see PatternEmitter), the weapon's patterns in turn
+        int patternCount = static_cast<int>(weapon->patterns.size());
+        const PatternParams& pattern = weapon->patterns[patternIndex % patternCount];
+        patternIndex = (patternIndex + 1) % patternCount;
+        game->bulletPatterns.Emit(pattern, startX, startY, baseVX, baseVY, Bullet::SizeOf(weapon->bulletType),
+                                  static_cast<int>(weapon->damage * Bullet::DamageMultiplierOf(weapon->bulletType)), this->bulletTexture);
+        Shooted = true;
+    } else if (weapon) {
+        // The type's weapon from the table, turned toward the player
+        for (const WeaponShot& shot : weapon->shots) {
+            float shotX, shotY, offsetX, offsetY;
+            AimShot(shot, baseVX, baseVY, shotX, shotY, offsetX, offsetY);
+            game->SpawnEnemyBullet(startX + offsetX, startY + offsetY, shotX, shotY, this->bulletTexture,
+                                   weapon->damage, weapon->bulletType);
             Shooted = true;
-            }
-            break;
         }
+    }
         if (Shooted && game) {
                  game->PlaySoundEffect(game->enemyShootSound);
         }
 }
 
-void Enemy::Render(SDL_Renderer* renderer, Player* player) {
-    SDL_Rect rect = {static_cast<int>(x - player->x + SCREEN_WIDTH / 2), static_cast<int>(y - player->y + SCREEN_HEIGHT / 2), width, height};
-    SDL_RenderCopyEx(renderer, texture, NULL, &rect, angle + 90, NULL, SDL_FLIP_NONE);
+void Enemy::Render(RenderSnapshot& snapshot, Player* player) {
+    SDL_Rect rect = {static_cast<int>(store->x[slot] - player->x + SCREEN_WIDTH / 2), static_cast<int>(store->y[slot] - player->y + SCREEN_HEIGHT / 2), width, height};
+    snapshot.AddSprite({texture, rect, DirectionToSpriteAngle(store->dirX[slot], store->dirY[slot]), 255});
 }
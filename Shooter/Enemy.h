@@ -2,22 +2,29 @@
 #define ENEMY_H
 
 #include "Bullet.h"
+#include "CollisionShapes.h"
+#include "CollisionMask.h"
+#include "EntityHandle.h"
+#include "WeaponTable.h"
+#include "Orientation.h"
+#include "TimerWheel.h"
 
 class Game;
+class EnemyStore;
 class Player;
 class Obstacle;
-class Bullet;
+struct RenderSnapshot;
 
+// Position, velocity, heading and speed live in the EnemyStore (hot,
+// structure-of-arrays); the fields here are the cold per-enemy data.
 class Enemy {
 public:
-    float x, y;
-    float vx, vy;
-    float angle;
+    EnemyStore* store;
+    int slot;
+    int typeSlot;               // in Game::enemyRegistry
     int width, height;
 
-    Player* target;
     int health;
-    float speed;
     float firingRateFactor;
     Uint32 lastShotTime;
     Game* game;
@@ -25,13 +32,37 @@ public:
     EnemyType type;
     EnemyState state;
     Uint32 lastStateChange;
-    float wanderingAngle;
+    float wanderDirX, wanderDirY;
     float circlingDirection;
+    float distanceToPlayer;
+    unsigned int lodPhase;      // staggers NEAR-tier updates, see AiLodScheduler
 
-    Enemy(float x, float y, SDL_Texture* selectedTexture, Player* target, int health, float speedFactor, float firingRateFactor, Game* game, EnemyType type, SDL_Texture* selectedBulletTexture);
-    void Update(std::vector<Enemy*>& enemies, std::vector<Obstacle*>& obstacles, std::vector<Bullet*>& enemyBullets, Player* player, Game* game);
-    void Shoot(std::vector<Bullet*>& enemyBullets);
-    void Render(SDL_Renderer* renderer, Player* player);
+    // Wake-ups from Game::timerWheel instead of polling the clock every frame.
+    // The callbacks hold the enemy's handle, not 'this' (see WakeTimer in Enemy.cpp).
+    TimerHandle stateTimer;
+    TimerHandle shotTimer;
+    bool stateDue;
+    bool shotReady;
+    bool clearShot;             // last line-of-sight answer, see Game::UpdateEnemies
+    const CollisionMask* mask;  // sprite pixels at this enemy's size, null if unavailable
+    int patternIndex;           // next volley in the weapon's pattern cycle, if it has patterns
+    const Weapon* weapon;       // from Game::weapons by type; null if the table has none
+
+    Enemy(float x, float y, SDL_Texture* selectedTexture, int health, float speedFactor, float firingRateFactor, Game* game, EnemyType type, SDL_Texture* selectedBulletTexture);
+    ~Enemy();
+    void Think(Player* player, Uint32 currentTime);
+    void Move(std::vector<Obstacle*>& obstacles, Uint32 currentTime);
+    void HoldCourse();
+    void ScheduleStateTimer(Uint32 currentTime);
+    void Coast();
+    bool WantsToShoot() const;
+    void Shoot();
+    void Render(RenderSnapshot& snapshot, Player* player);
+    float GetX() const;
+    float GetY() const;
+    SDL_Rect GetRect() const;
+    CollisionShape GetShape() const;
+    EntityHandle GetHandle() const;
     SDL_Texture* texture;
     SDL_Texture* bulletTexture;
 };
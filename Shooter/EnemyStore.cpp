@@ -0,0 +1,219 @@
+#include "EnemyStore.h"
+#include "Enemy.h"
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ENEMYSTORE_AVX 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ENEMYSTORE_SSE2 1
+#endif
+
+int EnemyStore::Add(Enemy* owner, float x_in, float y_in, float speed_in, float radius_in) {
+    x.push_back(x_in);
+    y.push_back(y_in);
+    vx.push_back(0.0f);
+    vy.push_back(0.0f);
+    targetVX.push_back(0.0f);
+    targetVY.push_back(0.0f);
+    speed.push_back(speed_in);
+    dirX.push_back(1.0f);
+    dirY.push_back(0.0f);
+    radius.push_back(radius_in);
+    active.push_back(1);
+    owners.push_back(owner);
+    int slot = static_cast<int>(owners.size()) - 1;
+    handles.push_back(handleTable.Create(slot));
+    return slot;
+}
+
+void EnemyStore::Remove(int slot) {
+    int last = static_cast<int>(owners.size()) - 1;
+    if (slot < 0 || slot > last) return;
+
+    handleTable.Release(handles[slot]);
+    if (slot != last) {
+        x[slot] = x[last];
+        y[slot] = y[last];
+        vx[slot] = vx[last];
+        vy[slot] = vy[last];
+        targetVX[slot] = targetVX[last];
+        targetVY[slot] = targetVY[last];
+        speed[slot] = speed[last];
+        dirX[slot] = dirX[last];
+        dirY[slot] = dirY[last];
+        radius[slot] = radius[last];
+        active[slot] = active[last];
+        owners[slot] = owners[last];
+        owners[slot]->slot = slot;
+        handles[slot] = handles[last];
+        handleTable.Relocate(handles[slot], slot);
+    }
+
+    x.pop_back();
+    y.pop_back();
+    vx.pop_back();
+    vy.pop_back();
+    targetVX.pop_back();
+    targetVY.pop_back();
+    speed.pop_back();
+    dirX.pop_back();
+    dirY.pop_back();
+    radius.pop_back();
+    active.pop_back();
+    owners.pop_back();
+    handles.pop_back();
+}
+
+void EnemyStore::Clear() {
+    for (const EntityHandle& handle : handles) handleTable.Release(handle);
+    x.clear();
+    y.clear();
+    vx.clear();
+    vy.clear();
+    targetVX.clear();
+    targetVY.clear();
+    speed.clear();
+    dirX.clear();
+    dirY.clear();
+    radius.clear();
+    active.clear();
+    owners.clear();
+    handles.clear();
+}
+
+int EnemyStore::GetCount() const {
+    return static_cast<int>(owners.size());
+}
+
+Enemy* EnemyStore::Find(const EntityHandle& handle) const {
+    int slot = handleTable.Resolve(handle);
+    return (slot >= 0) ? owners[slot] : nullptr;
+}
+
+void SteerVelocitiesScalar(float* vx, float* vy, const float* targetVX, const float* targetVY,
+                           const float* speed, float maxForce, int count) {
+    for (int i = 0; i < count; ++i) {
+        // --- Apply Accumulated Forces (Smoothly) ---
+        float newVX = vx[i] + std::clamp(targetVX[i] - vx[i], -maxForce, maxForce);
+        float newVY = vy[i] + std::clamp(targetVY[i] - vy[i], -maxForce, maxForce);
+
+        // --- Limit Speed ---
+        float currentSpeed = std::sqrt(newVX * newVX + newVY * newVY);
+        if (currentSpeed > speed[i]) {
+            newVX = (newVX / currentSpeed) * speed[i];
+            newVY = (newVY / currentSpeed) * speed[i];
+        }
+        vx[i] = newVX;
+        vy[i] = newVY;
+    }
+}
+
+void SteerVelocities(float* vx, float* vy, const float* targetVX, const float* targetVY,
+                     const float* speed, float maxForce, int count) {
+    int i = 0;
+#ifdef ENEMYSTORE_AVX
+    {
+        const __m256 hi = _mm256_set1_ps(maxForce);
+        const __m256 lo = _mm256_set1_ps(-maxForce);
+        for (; i + 8 <= count; i += 8) {
+            __m256 curVX = _mm256_loadu_ps(vx + i);
+            __m256 curVY = _mm256_loadu_ps(vy + i);
+            __m256 limit = _mm256_loadu_ps(speed + i);
+
+            __m256 forceX = _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(targetVX + i), curVX), lo), hi);
+            __m256 forceY = _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(targetVY + i), curVY), lo), hi);
+            curVX = _mm256_add_ps(curVX, forceX);
+            curVY = _mm256_add_ps(curVY, forceY);
+
+            // Lanes under the limit keep their velocity; the rest are rescaled.
+            // Stationary lanes divide 0/0 but are never selected.
+            __m256 currentSpeed = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(curVX, curVX), _mm256_mul_ps(curVY, curVY)));
+            __m256 over = _mm256_cmp_ps(currentSpeed, limit, _CMP_GT_OQ);
+            __m256 limitedVX = _mm256_mul_ps(_mm256_div_ps(curVX, currentSpeed), limit);
+            __m256 limitedVY = _mm256_mul_ps(_mm256_div_ps(curVY, currentSpeed), limit);
+            _mm256_storeu_ps(vx + i, _mm256_blendv_ps(curVX, limitedVX, over));
+            _mm256_storeu_ps(vy + i, _mm256_blendv_ps(curVY, limitedVY, over));
+        }
+    }
+#endif
+#ifdef ENEMYSTORE_SSE2
+    {
+        const __m128 hi = _mm_set1_ps(maxForce);
+        const __m128 lo = _mm_set1_ps(-maxForce);
+        for (; i + 4 <= count; i += 4) {
+            __m128 curVX = _mm_loadu_ps(vx + i);
+            __m128 curVY = _mm_loadu_ps(vy + i);
+            __m128 limit = _mm_loadu_ps(speed + i);
+
+            __m128 forceX = _mm_min_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(targetVX + i), curVX), lo), hi);
+            __m128 forceY = _mm_min_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(targetVY + i), curVY), lo), hi);
+            curVX = _mm_add_ps(curVX, forceX);
+            curVY = _mm_add_ps(curVY, forceY);
+
+            __m128 currentSpeed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(curVX, curVX), _mm_mul_ps(curVY, curVY)));
+            __m128 over = _mm_cmpgt_ps(currentSpeed, limit);
+            __m128 limitedVX = _mm_mul_ps(_mm_div_ps(curVX, currentSpeed), limit);
+            __m128 limitedVY = _mm_mul_ps(_mm_div_ps(curVY, currentSpeed), limit);
+            _mm_storeu_ps(vx + i, _mm_or_ps(_mm_and_ps(over, limitedVX), _mm_andnot_ps(over, curVX)));
+            _mm_storeu_ps(vy + i, _mm_or_ps(_mm_and_ps(over, limitedVY), _mm_andnot_ps(over, curVY)));
+        }
+    }
+#endif
+    SteerVelocitiesScalar(vx + i, vy + i, targetVX + i, targetVY + i, speed + i, maxForce, count - i);
+}
+
+void SteerEnemies(EnemyStore& store, float maxForce) {
+    int count = store.GetCount();
+    if (count == 0) return;
+    SteerVelocities(store.vx.data(), store.vy.data(), store.targetVX.data(), store.targetVY.data(),
+                    store.speed.data(), maxForce, count);
+}
+
+void ApplySeparation(EnemyStore& store, SpatialGrid& grid, float weight, float padding) {
+    int count = store.GetCount();
+    grid.Clear();
+    for (int i = 0; i < count; ++i) {
+        grid.Insert(i, store.x[i] + store.radius[i], store.y[i] + store.radius[i], store.radius[i]);
+    }
+    grid.Build();
+
+    // Kept on the store so the per-frame queries reuse one allocation
+    std::vector<int>& neighbors = store.neighbors;
+    for (int i = 0; i < count; ++i) {
+        if (!store.active[i]) continue;   // coasting enemies still count as neighbours
+
+        float centerX = store.x[i] + store.radius[i];
+        float centerY = store.y[i] + store.radius[i];
+
+        neighbors.clear();
+        grid.Query(centerX, centerY, store.radius[i] + padding, neighbors);
+
+        float pushX = 0.0f, pushY = 0.0f;
+        for (int j : neighbors) {
+            if (j == i) continue;
+            float dx = centerX - (store.x[j] + store.radius[j]);
+            float dy = centerY - (store.y[j] + store.radius[j]);
+            float minDistance = store.radius[i] + store.radius[j] + padding;
+            float distanceSq = dx * dx + dy * dy;
+            if (distanceSq >= minDistance * minDistance) continue;
+
+            float distance = std::sqrt(distanceSq);
+            float strength = 1.0f - distance / minDistance;
+            if (distance > 0.001f) {
+                pushX += dx / distance * strength;
+                pushY += dy / distance * strength;
+            } else {
+                // Exactly stacked (same spawn point): split them sideways by slot order
+                pushX += (i < j) ? -strength : strength;
+            }
+        }
+
+        store.targetVX[i] += pushX * store.speed[i] * weight;
+        store.targetVY[i] += pushY * store.speed[i] * weight;
+    }
+}
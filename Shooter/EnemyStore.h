@@ -0,0 +1,55 @@
+#ifndef ENEMYSTORE_H
+#define ENEMYSTORE_H
+
+#include <vector>
+#include "EntityHandle.h"
+
+class Enemy;
+class SpatialGrid;
+
+// Hot per-enemy state kept as structure-of-arrays, so the steering kernel
+// streams through contiguous floats instead of hopping between Enemy objects.
+// Cold data (textures, timers, AI state) stays on the Enemy, which only
+// remembers its slot here. Removal swaps the last slot into the hole and
+// fixes up that enemy's slot index. Anything that keeps an enemy across
+// frames (timer callbacks) holds its EntityHandle, which follows those moves.
+class EnemyStore {
+public:
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+    std::vector<float> targetVX, targetVY;   // written by Enemy::Think
+    std::vector<float> speed;                // speed limit
+    std::vector<float> dirX, dirY;           // unit heading
+    std::vector<float> radius;               // half the sprite size; x, y is the top-left corner
+    std::vector<unsigned char> active;       // set by AiLodScheduler: full AI this tick or coasting
+    std::vector<Enemy*> owners;
+    std::vector<EntityHandle> handles;
+    std::vector<int> neighbors;              // ApplySeparation's query results; cleared, never shrunk
+
+    int Add(Enemy* owner, float x, float y, float speed, float radius);
+    void Remove(int slot);
+    void Clear();
+    int GetCount() const;
+    Enemy* Find(const EntityHandle& handle) const;   // null once that enemy is removed
+
+private:
+    HandleTable handleTable;
+};
+
+// Moves each velocity toward its target by at most maxForce per axis, then
+// limits it to that enemy's speed. Uses AVX (8 lanes) or SSE2 (4 lanes) when
+// the compiler targets them; every path gives the same results as the scalar
+// version.
+void SteerVelocities(float* vx, float* vy, const float* targetVX, const float* targetVY,
+                     const float* speed, float maxForce, int count);
+void SteerVelocitiesScalar(float* vx, float* vy, const float* targetVX, const float* targetVY,
+                           const float* speed, float maxForce, int count);
+
+void SteerEnemies(EnemyStore& store, float maxForce);
+
+// Boids-style separation: rebuilds the grid from the store, then pushes each
+// active enemy's target velocity away from every enemy whose circle (plus padding) overlaps
+// its own, scaled by how deep the overlap is.
+void ApplySeparation(EnemyStore& store, SpatialGrid& grid, float weight, float padding);
+
+#endif
@@ -0,0 +1,40 @@
+#include "EntityHandle.h"
+
+EntityHandle HandleTable::Create(int slot) {
+    int index;
+    if (!freeEntries.empty()) {
+        index = freeEntries.back();
+        freeEntries.pop_back();
+    } else {
+        index = static_cast<int>(entries.size());
+        entries.push_back({-1, 1});     // generation 0 is never handed out, see EntityHandle()
+    }
+    entries[index].slot = slot;
+
+    EntityHandle handle;
+    handle.index = index;
+    handle.generation = entries[index].generation;
+    return handle;
+}
+
+bool HandleTable::IsValid(const EntityHandle& handle) const {
+    if (handle.index < 0 || handle.index >= static_cast<int>(entries.size())) return false;
+    const Entry& entry = entries[handle.index];
+    return entry.generation == handle.generation && entry.slot >= 0;
+}
+
+void HandleTable::Release(const EntityHandle& handle) {
+    if (!IsValid(handle)) return;
+    Entry& entry = entries[handle.index];
+    entry.slot = -1;
+    if (++entry.generation == 0) entry.generation = 1;
+    freeEntries.push_back(handle.index);
+}
+
+void HandleTable::Relocate(const EntityHandle& handle, int slot) {
+    if (IsValid(handle)) entries[handle.index].slot = slot;
+}
+
+int HandleTable::Resolve(const EntityHandle& handle) const {
+    return IsValid(handle) ? entries[handle.index].slot : -1;
+}
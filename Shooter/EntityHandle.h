@@ -0,0 +1,39 @@
+#ifndef ENTITYHANDLE_H
+#define ENTITYHANDLE_H
+
+#include <SDL.h>
+#include <vector>
+
+// Names an entity without pointing at it: 8 bytes, safe to keep after the
+// entity is gone. Like TimerHandle, a stale handle fails the generation
+// check instead of dangling.
+struct EntityHandle {
+    int index;
+    Uint32 generation;
+
+    EntityHandle() : index(-1), generation(0) {}
+};
+
+// Maps handles to wherever their entity currently lives (a slot in some
+// store). The store calls Relocate when it moves an entity, so handles stay
+// valid across compaction; Release bumps the generation so every copy of the
+// handle stops resolving. Freed entries are reused.
+class HandleTable {
+public:
+    EntityHandle Create(int slot);
+    void Release(const EntityHandle& handle);
+    void Relocate(const EntityHandle& handle, int slot);
+    int Resolve(const EntityHandle& handle) const;   // slot, or -1 if stale
+    bool IsValid(const EntityHandle& handle) const;
+
+private:
+    struct Entry {
+        int slot;               // -1 while free
+        Uint32 generation;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<int> freeEntries;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef ENTITYREGISTRY_H
+#define ENTITYREGISTRY_H
+
+#include <vector>
+
+// Live entities bucketed by their type enum, so per-type logic runs as one
+// loop per bucket instead of a switch per entity, and "how many of X" is a
+// size() instead of a scan. The owning vectors (Game::enemies, obstacles)
+// keep their order for rendering and collision; this only indexes them.
+// T needs a 'type' field of enum Type, fixed for its lifetime, and an
+// 'int typeSlot'. Removal swaps the bucket's last entity into the hole and
+// fixes up its typeSlot, like EnemyStore.
+template <typename T, typename Type, int TYPE_COUNT>
+class EntityRegistry {
+public:
+    void Add(T* entity) {
+        std::vector<T*>& bucket = buckets[static_cast<int>(entity->type)];
+        entity->typeSlot = static_cast<int>(bucket.size());
+        bucket.push_back(entity);
+    }
+
+    void Remove(T* entity) {
+        if (entity->typeSlot < 0) return;
+        std::vector<T*>& bucket = buckets[static_cast<int>(entity->type)];
+        T* moved = bucket.back();
+        bucket[entity->typeSlot] = moved;
+        moved->typeSlot = entity->typeSlot;
+        bucket.pop_back();
+        entity->typeSlot = -1;
+    }
+
+    const std::vector<T*>& Of(Type type) const {
+        return buckets[static_cast<int>(type)];
+    }
+
+    int Count(Type type) const {
+        return static_cast<int>(buckets[static_cast<int>(type)].size());
+    }
+
+private:
+    std::vector<T*> buckets[TYPE_COUNT];
+};
+
+#endif
@@ -0,0 +1,159 @@
+#include "FastMath.h"
+#include <cfloat>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FASTMATH_SSE2 1
+#endif
+
+const float FAST_PI = 3.14159265358979f;
+const float FAST_TWO_PI = 6.28318530717959f;
+const float FAST_HALF_PI = 1.57079632679490f;
+const float FAST_DEG_TO_RAD = 0.0174532925199433f;
+const float FAST_RAD_TO_DEG = 57.2957795130823f;
+
+// --- atan on [0, 1] (Abramowitz & Stegun 4.4.49, |error| <= 1e-5) ---
+static const float ATAN_C0 = 0.9998660f;
+static const float ATAN_C1 = -0.3302995f;
+static const float ATAN_C2 = 0.1801410f;
+static const float ATAN_C3 = -0.0851330f;
+static const float ATAN_C4 = 0.0208351f;
+
+// --- sin/cos on [-pi/4, pi/4] (Cephes sinf/cosf minimax) ---
+static const float TWO_OVER_PI = 0.636619772367581f;
+static const float HALF_PI_1 = 1.5703125f;                    // Cody-Waite split of pi/2, the first
+static const float HALF_PI_2 = 4.837512969970703125e-4f;      // two parts have few enough bits that
+static const float HALF_PI_3 = 7.54978995489188216e-8f;       // q * part stays exact
+static const float SIN_C1 = -1.6666654611e-1f;
+static const float SIN_C2 = 8.3321608736e-3f;
+static const float SIN_C3 = -1.9515295891e-4f;
+static const float COS_C1 = 4.166664568298827e-2f;
+static const float COS_C2 = -1.388731625493765e-3f;
+static const float COS_C3 = 2.443315711809948e-5f;
+
+float FastAtan2(float y, float x) {
+    float ax = x < 0.0f ? -x : x;
+    float ay = y < 0.0f ? -y : y;
+    float maxAbs = ax > ay ? ax : ay;
+    float minAbs = ax > ay ? ay : ax;
+
+    // atan2(0, 0) = 0, like the SSE path below
+    float a = minAbs / (maxAbs > FLT_MIN ? maxAbs : FLT_MIN);
+    float s = a * a;
+    float r = ((((ATAN_C4 * s + ATAN_C3) * s + ATAN_C2) * s + ATAN_C1) * s + ATAN_C0) * a;
+
+    if (ay > ax) r = FAST_HALF_PI - r;
+    if (x < 0.0f) r = FAST_PI - r;
+    if (y < 0.0f) r = -r;
+    return r;
+}
+
+void FastSinCos(float radians, float& sine, float& cosine) {
+    // Reduce to r in [-pi/4, pi/4] and a quadrant
+    float scaled = radians * TWO_OVER_PI;
+    int quadrant = static_cast<int>(scaled + (scaled < 0.0f ? -0.5f : 0.5f));
+    float q = static_cast<float>(quadrant);
+    float r = ((radians - q * HALF_PI_1) - q * HALF_PI_2) - q * HALF_PI_3;
+    float r2 = r * r;
+
+    float s = ((SIN_C3 * r2 + SIN_C2) * r2 + SIN_C1) * r2 * r + r;
+    float c = ((COS_C3 * r2 + COS_C2) * r2 + COS_C1) * r2 * r2 - 0.5f * r2 + 1.0f;
+
+    // Odd quadrants swap sin/cos; bit 1 of q (or q + 1) flips the sign
+    bool swap = (quadrant & 1) != 0;
+    float sinBase = swap ? c : s;
+    float cosBase = swap ? s : c;
+    sine = (quadrant & 2) ? -sinBase : sinBase;
+    cosine = ((quadrant + 1) & 2) ? -cosBase : cosBase;
+}
+
+float FastSin(float radians) {
+    float s, c;
+    FastSinCos(radians, s, c);
+    return s;
+}
+
+float FastCos(float radians) {
+    float s, c;
+    FastSinCos(radians, s, c);
+    return c;
+}
+
+#ifdef FASTMATH_SSE2
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+void FastAtan2Batch(const float* y, const float* x, float* radians, int count) {
+    int i = 0;
+#ifdef FASTMATH_SSE2
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_loadu_ps(x + i);
+        __m128 vy = _mm_loadu_ps(y + i);
+        __m128 ax = _mm_andnot_ps(signBit, vx);
+        __m128 ay = _mm_andnot_ps(signBit, vy);
+        __m128 maxAbs = _mm_max_ps(ax, ay);
+        __m128 minAbs = _mm_min_ps(ax, ay);
+
+        __m128 a = _mm_div_ps(minAbs, _mm_max_ps(maxAbs, _mm_set1_ps(FLT_MIN)));
+        __m128 s = _mm_mul_ps(a, a);
+        __m128 r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(ATAN_C4), s), _mm_set1_ps(ATAN_C3));
+        r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(ATAN_C2));
+        r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(ATAN_C1));
+        r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(ATAN_C0));
+        r = _mm_mul_ps(r, a);
+
+        r = Select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(FAST_HALF_PI), r), r);
+        r = Select(_mm_cmplt_ps(vx, zero), _mm_sub_ps(_mm_set1_ps(FAST_PI), r), r);
+        r = _mm_xor_ps(r, _mm_and_ps(_mm_cmplt_ps(vy, zero), signBit));
+        _mm_storeu_ps(radians + i, r);
+    }
+#endif
+    for (; i < count; ++i) {
+        radians[i] = FastAtan2(y[i], x[i]);
+    }
+}
+
+void FastSinCosBatch(const float* radians, float* sines, float* cosines, int count) {
+    int i = 0;
+#ifdef FASTMATH_SSE2
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i two = _mm_set1_epi32(2);
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_loadu_ps(radians + i);
+        __m128 scaled = _mm_mul_ps(v, _mm_set1_ps(TWO_OVER_PI));
+        __m128 half = _mm_or_ps(_mm_and_ps(scaled, signBit), _mm_set1_ps(0.5f));
+        __m128i quadrant = _mm_cvttps_epi32(_mm_add_ps(scaled, half));
+        __m128 q = _mm_cvtepi32_ps(quadrant);
+
+        __m128 r = _mm_sub_ps(v, _mm_mul_ps(q, _mm_set1_ps(HALF_PI_1)));
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(HALF_PI_2)));
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(HALF_PI_3)));
+        __m128 r2 = _mm_mul_ps(r, r);
+
+        __m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_C3), r2), _mm_set1_ps(SIN_C2));
+        s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(SIN_C1));
+        s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, r2), r), r);
+
+        __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_C3), r2), _mm_set1_ps(COS_C2));
+        c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(COS_C1));
+        c = _mm_mul_ps(_mm_mul_ps(c, r2), r2);
+        c = _mm_add_ps(_mm_sub_ps(c, _mm_mul_ps(_mm_set1_ps(0.5f), r2)), _mm_set1_ps(1.0f));
+
+        // Odd quadrants swap sin/cos; bit 1 of q (or q + 1) flips the sign
+        __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+        __m128 sinNeg = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+        __m128 cosNeg = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+
+        _mm_storeu_ps(sines + i, _mm_xor_ps(Select(swap, c, s), sinNeg));
+        _mm_storeu_ps(cosines + i, _mm_xor_ps(Select(swap, s, c), cosNeg));
+    }
+#endif
+    for (; i < count; ++i) {
+        FastSinCos(radians[i], sines[i], cosines[i]);
+    }
+}
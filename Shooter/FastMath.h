@@ -0,0 +1,25 @@
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+// Polynomial approximations for the per-frame steering, aiming and shooting
+// code. Bounded error, no libm calls:
+//   FastAtan2   max abs error ~1e-5 rad
+//   FastSinCos  max abs error ~2e-7 for |radians| < 1e4
+// The batch variants use SSE2 four lanes at a time when available and give
+// the same results as the scalar versions.
+
+extern const float FAST_PI;
+extern const float FAST_TWO_PI;
+extern const float FAST_HALF_PI;
+extern const float FAST_DEG_TO_RAD;
+extern const float FAST_RAD_TO_DEG;
+
+float FastAtan2(float y, float x);
+void FastSinCos(float radians, float& sine, float& cosine);
+float FastSin(float radians);
+float FastCos(float radians);
+
+void FastAtan2Batch(const float* y, const float* x, float* radians, int count);
+void FastSinCosBatch(const float* radians, float* sines, float* cosines, int count);
+
+#endif
@@ -0,0 +1,170 @@
+#include "FlowField.h"
+#include "Globals.h"
+#include "Obstacle.h"
+#include <queue>
+#include <functional>
+#include <limits>
+
+static const float UNREACHABLE = std::numeric_limits<float>::max();
+static const float DIAGONAL_COST = 1.41421356f;
+
+// 8 neighbours; the first four are the straight ones
+static const int NEIGHBOR_DX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int NEIGHBOR_DY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+FlowField::FlowField()
+    : originX(0), originY(0), targetCellX(0), targetCellY(0), ticksUntilRebuild(0), built(false) {
+    int cellCount = FLOW_FIELD_DIMENSION * FLOW_FIELD_DIMENSION;
+    blocked.assign(cellCount, 0);
+    distance.assign(cellCount, UNREACHABLE);
+    flowX.assign(cellCount, 0.0f);
+    flowY.assign(cellCount, 0.0f);
+}
+
+void FlowField::Update(float targetX, float targetY, const std::vector<Obstacle*>& obstacles) {
+    if (ticksUntilRebuild > 0) {
+        --ticksUntilRebuild;
+        return;
+    }
+    Rebuild(targetX, targetY, obstacles);
+    ticksUntilRebuild = FLOW_FIELD_REBUILD_TICKS - 1;
+}
+
+void FlowField::Invalidate() {
+    ticksUntilRebuild = 0;
+    built = false;
+}
+
+bool FlowField::Sample(float worldX, float worldY, float& dirX, float& dirY) const {
+    if (!built) return false;
+
+    int cellX = static_cast<int>(std::floor((worldX - originX) / FLOW_FIELD_CELL_SIZE));
+    int cellY = static_cast<int>(std::floor((worldY - originY) / FLOW_FIELD_CELL_SIZE));
+    if (cellX < 0 || cellY < 0 || cellX >= FLOW_FIELD_DIMENSION || cellY >= FLOW_FIELD_DIMENSION) return false;
+
+    // Close to the target the grid is too coarse to be useful
+    if (std::abs(cellX - targetCellX) <= 1 && std::abs(cellY - targetCellY) <= 1) return false;
+
+    int index = cellY * FLOW_FIELD_DIMENSION + cellX;
+    if (blocked[index] || distance[index] == UNREACHABLE) return false;
+
+    dirX = flowX[index];
+    dirY = flowY[index];
+    return true;
+}
+
+void FlowField::Rebuild(float targetX, float targetY, const std::vector<Obstacle*>& obstacles) {
+    // Snap the origin to whole cells so cell boundaries stay put in the world
+    int halfExtent = FLOW_FIELD_DIMENSION / 2 * FLOW_FIELD_CELL_SIZE;
+    originX = static_cast<int>(std::floor(targetX / FLOW_FIELD_CELL_SIZE)) * FLOW_FIELD_CELL_SIZE - halfExtent;
+    originY = static_cast<int>(std::floor(targetY / FLOW_FIELD_CELL_SIZE)) * FLOW_FIELD_CELL_SIZE - halfExtent;
+    targetCellX = static_cast<int>(std::floor((targetX - originX) / FLOW_FIELD_CELL_SIZE));
+    targetCellY = static_cast<int>(std::floor((targetY - originY) / FLOW_FIELD_CELL_SIZE));
+
+    RasterizeObstacles(obstacles);
+    Integrate(targetCellY * FLOW_FIELD_DIMENSION + targetCellX);
+    BuildDirections();
+    built = true;
+}
+
+void FlowField::RasterizeObstacles(const std::vector<Obstacle*>& obstacles) {
+    std::fill(blocked.begin(), blocked.end(), 0);
+
+    for (const auto& obs : obstacles) {
+        if (!obs) continue;
+        // Grow by the margin (and the hover amplitude) so an enemy centre
+        // following the field keeps its body clear of the obstacle
+        float margin = FLOW_FIELD_OBSTACLE_MARGIN + OBSTACLE_HOVER_AMPLITUDE;
+        int minX = static_cast<int>(std::floor((obs->x - margin - originX) / FLOW_FIELD_CELL_SIZE));
+        int minY = static_cast<int>(std::floor((obs->y - margin - originY) / FLOW_FIELD_CELL_SIZE));
+        int maxX = static_cast<int>(std::floor((obs->x + obs->width + margin - originX) / FLOW_FIELD_CELL_SIZE));
+        int maxY = static_cast<int>(std::floor((obs->y + obs->height + margin - originY) / FLOW_FIELD_CELL_SIZE));
+
+        minX = std::max(minX, 0);
+        minY = std::max(minY, 0);
+        maxX = std::min(maxX, FLOW_FIELD_DIMENSION - 1);
+        maxY = std::min(maxY, FLOW_FIELD_DIMENSION - 1);
+
+        for (int cy = minY; cy <= maxY; ++cy) {
+            for (int cx = minX; cx <= maxX; ++cx) {
+                blocked[cy * FLOW_FIELD_DIMENSION + cx] = 1;
+            }
+        }
+    }
+}
+
+bool FlowField::IsPassable(int cellX, int cellY) const {
+    if (cellX < 0 || cellY < 0 || cellX >= FLOW_FIELD_DIMENSION || cellY >= FLOW_FIELD_DIMENSION) return false;
+    return !blocked[cellY * FLOW_FIELD_DIMENSION + cellX];
+}
+
+void FlowField::Integrate(int targetCell) {
+    std::fill(distance.begin(), distance.end(), UNREACHABLE);
+
+    typedef std::pair<float, int> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> open;
+
+    // The target cell is seeded even if an obstacle covers it
+    distance[targetCell] = 0.0f;
+    open.push({0.0f, targetCell});
+
+    while (!open.empty()) {
+        QueueEntry current = open.top();
+        open.pop();
+        int index = current.second;
+        if (current.first > distance[index]) continue;   // stale entry
+
+        int cellX = index % FLOW_FIELD_DIMENSION;
+        int cellY = index / FLOW_FIELD_DIMENSION;
+        for (int n = 0; n < 8; ++n) {
+            int nx = cellX + NEIGHBOR_DX[n];
+            int ny = cellY + NEIGHBOR_DY[n];
+            if (!IsPassable(nx, ny)) continue;
+
+            // No cutting across the corner of a blocked cell
+            bool diagonal = n >= 4;
+            if (diagonal && (!IsPassable(cellX + NEIGHBOR_DX[n], cellY) || !IsPassable(cellX, cellY + NEIGHBOR_DY[n]))) continue;
+
+            int neighbor = ny * FLOW_FIELD_DIMENSION + nx;
+            float newDistance = current.first + (diagonal ? DIAGONAL_COST : 1.0f);
+            if (newDistance < distance[neighbor]) {
+                distance[neighbor] = newDistance;
+                open.push({newDistance, neighbor});
+            }
+        }
+    }
+}
+
+void FlowField::BuildDirections() {
+    for (int cellY = 0; cellY < FLOW_FIELD_DIMENSION; ++cellY) {
+        for (int cellX = 0; cellX < FLOW_FIELD_DIMENSION; ++cellX) {
+            int index = cellY * FLOW_FIELD_DIMENSION + cellX;
+            flowX[index] = 0.0f;
+            flowY[index] = 0.0f;
+            if (distance[index] == UNREACHABLE) continue;
+
+            // Point at the neighbour with the smallest path distance, using the
+            // same corner rule as the integration pass
+            float best = distance[index];
+            int bestN = -1;
+            for (int n = 0; n < 8; ++n) {
+                int nx = cellX + NEIGHBOR_DX[n];
+                int ny = cellY + NEIGHBOR_DY[n];
+                if (nx < 0 || ny < 0 || nx >= FLOW_FIELD_DIMENSION || ny >= FLOW_FIELD_DIMENSION) continue;
+                if (n >= 4 && (!IsPassable(cellX + NEIGHBOR_DX[n], cellY) || !IsPassable(cellX, cellY + NEIGHBOR_DY[n]))) continue;
+
+                float d = distance[ny * FLOW_FIELD_DIMENSION + nx];
+                if (d < best) {
+                    best = d;
+                    bestN = n;
+                }
+            }
+
+            if (bestN >= 0) {
+                float scale = (bestN >= 4) ? 1.0f / DIAGONAL_COST : 1.0f;
+                flowX[index] = NEIGHBOR_DX[bestN] * scale;
+                flowY[index] = NEIGHBOR_DY[bestN] * scale;
+            }
+        }
+    }
+}
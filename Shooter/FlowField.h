@@ -0,0 +1,46 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include <vector>
+#include <SDL.h>
+
+class Obstacle;
+
+// Shared navigation toward the player. A square grid of FLOW_FIELD_CELL_SIZE
+// cells is centred on the target; obstacles (grown by a margin so big enemies
+// clear them) mark cells as blocked, a Dijkstra pass from the target cell
+// gives every cell its path distance, and each cell stores the unit direction
+// to its cheapest neighbour. Enemies then read their direction in O(1)
+// instead of scanning obstacles themselves.
+class FlowField {
+public:
+    FlowField();
+
+    // Rebuilds once every FLOW_FIELD_REBUILD_TICKS calls (or right away after
+    // Invalidate). Between rebuilds the field is reused as-is.
+    void Update(float targetX, float targetY, const std::vector<Obstacle*>& obstacles);
+    void Invalidate();
+
+    // Direction to follow from a world position. Returns false outside the
+    // grid, on blocked or unreachable cells and right next to the target,
+    // where the caller should just seek directly.
+    bool Sample(float worldX, float worldY, float& dirX, float& dirY) const;
+
+private:
+    void Rebuild(float targetX, float targetY, const std::vector<Obstacle*>& obstacles);
+    void RasterizeObstacles(const std::vector<Obstacle*>& obstacles);
+    void Integrate(int targetCell);
+    void BuildDirections();
+    bool IsPassable(int cellX, int cellY) const;
+
+    int originX, originY;          // world position of the grid's top-left corner
+    int targetCellX, targetCellY;
+    int ticksUntilRebuild;
+    bool built;
+
+    std::vector<Uint8> blocked;
+    std::vector<float> distance;
+    std::vector<float> flowX, flowY;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+
+FrameArena::FrameArena(size_t capacity_in)
+    : buffer(new char[capacity_in]), capacity(capacity_in), offset(0), overflowCount(0), overflowLock(SDL_CreateMutex()),
+      lastFrameBytes(0), peakBytes(0), lastFrameOverflows(0) {}
+
+FrameArena::~FrameArena() {
+    Reset();
+    if (overflowLock) SDL_DestroyMutex(overflowLock);
+    delete[] buffer;
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+    if (size == 0) size = 1;
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer);
+    size_t current = offset.load(std::memory_order_relaxed);
+    while (true) {
+        size_t start = ((base + current + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1)) - base;
+        size_t end = start + size;
+        if (end > capacity) break;
+        if (offset.compare_exchange_weak(current, end, std::memory_order_relaxed)) return buffer + start;
+    }
+
+    // Out of room this frame: heap, handed back at Reset
+    void* block = ::operator new(size);
+    overflowCount.fetch_add(1, std::memory_order_relaxed);
+    SDL_LockMutex(overflowLock);
+    overflowBlocks.push_back(block);
+    SDL_UnlockMutex(overflowLock);
+    return block;
+}
+
+void FrameArena::Reset() {
+    lastFrameBytes = std::min(offset.load(std::memory_order_relaxed), capacity);
+    peakBytes = std::max(peakBytes, lastFrameBytes);
+    lastFrameOverflows = overflowCount.load(std::memory_order_relaxed);
+
+    for (void* block : overflowBlocks) ::operator delete(block);
+    overflowBlocks.clear();
+    offset.store(0, std::memory_order_relaxed);
+    overflowCount.store(0, std::memory_order_relaxed);
+}
+
+const char* FrameArena::Format(const char* format, ...) {
+    va_list args, measure;
+    va_start(args, format);
+    va_copy(measure, args);
+    int length = std::vsnprintf(nullptr, 0, format, measure);
+    va_end(measure);
+    if (length < 0) { va_end(args); return ""; }
+
+    char* text = static_cast<char*>(Allocate(static_cast<size_t>(length) + 1, 1));
+    std::vsnprintf(text, static_cast<size_t>(length) + 1, format, args);
+    va_end(args);
+    return text;
+}
+
+size_t FrameArena::GetLastFrameBytes() const {
+    return lastFrameBytes;
+}
+
+size_t FrameArena::GetPeakBytes() const {
+    return peakBytes;
+}
+
+int FrameArena::GetLastFrameOverflows() const {
+    return lastFrameOverflows;
+}
+
+size_t FrameArena::GetCapacity() const {
+    return capacity;
+}
@@ -0,0 +1,71 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <SDL.h>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bump-pointer memory for data that lives one frame at most. Allocate is a
+// lock-free bump, so job threads inside the frame graph can share one arena;
+// nothing is freed individually, Reset at the start of the next frame takes
+// everything back at once. When the block runs out, allocations fall back to
+// the heap (counted in the stats) and are released at the next Reset too.
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity);
+    ~FrameArena();
+
+    void* Allocate(size_t size, size_t alignment);
+    void Reset();   // no pointer from before the Reset may be used after it
+
+    // printf into the arena; the text is valid until the next Reset
+    const char* Format(const char* format, ...);
+
+    // --- Stats of the last finished frame (the one before the last Reset) ---
+    size_t GetLastFrameBytes() const;
+    size_t GetPeakBytes() const;
+    int GetLastFrameOverflows() const;
+    size_t GetCapacity() const;
+
+private:
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    char* buffer;
+    size_t capacity;
+    std::atomic<size_t> offset;
+    std::atomic<int> overflowCount;
+    SDL_mutex* overflowLock;
+    std::vector<void*> overflowBlocks;
+    size_t lastFrameBytes;
+    size_t peakBytes;
+    int lastFrameOverflows;
+};
+
+// STL allocator handing out FrameArena memory; deallocate does nothing.
+// Containers using it must not outlive the frame.
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    explicit ArenaAllocator(FrameArena* arena) : arena(arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) { return static_cast<T*>(arena->Allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+
+    FrameArena* arena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena == b.arena; }
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena != b.arena; }
+
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif
@@ -0,0 +1,78 @@
+#include "FrameGraph.h"
+
+FrameGraph::FrameGraph() : built(false) {}
+
+int FrameGraph::AddTask(const char* name, Uint32 reads, Uint32 writes, std::function<void()> body) {
+    tasks.emplace_back();
+    FrameTask& task = tasks.back();
+    task.name = name;
+    task.reads = reads;
+    task.writes = writes;
+    task.body = std::move(body);
+    task.dependencyCount = 0;
+    task.pending = 0;
+    built = false;
+    return static_cast<int>(tasks.size()) - 1;
+}
+
+void FrameGraph::Build() {
+    for (auto& task : tasks) {
+        task.successors.clear();
+        task.dependencyCount = 0;
+    }
+
+    // Earlier task -> later task whenever one writes something the other uses
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        for (size_t j = i + 1; j < tasks.size(); ++j) {
+            FrameTask& first = tasks[i];
+            FrameTask& second = tasks[j];
+            bool conflict = (first.writes & (second.reads | second.writes)) != 0 ||
+                            (first.reads & second.writes) != 0;
+            if (conflict) {
+                first.successors.push_back(static_cast<int>(j));
+                second.dependencyCount++;
+            }
+        }
+    }
+    built = true;
+}
+
+void FrameGraph::Execute(JobSystem& jobs) {
+    if (tasks.empty()) return;
+    if (!built) Build();
+
+    for (auto& task : tasks) {
+        task.pending.store(task.dependencyCount, std::memory_order_relaxed);
+    }
+
+    JobCounter remaining(0);
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (tasks[i].dependencyCount == 0) {
+            Dispatch(jobs, static_cast<int>(i), &remaining);
+        }
+    }
+    jobs.Wait(&remaining);
+}
+
+void FrameGraph::Dispatch(JobSystem& jobs, int index, JobCounter* remaining) {
+    jobs.Submit([this, &jobs, index, remaining]() {
+        FrameTask& task = tasks[index];
+        task.body();
+        // Successors are submitted before this job's counter drops, so
+        // 'remaining' never reaches zero while work is still outstanding
+        for (int successor : task.successors) {
+            if (tasks[successor].pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Dispatch(jobs, successor, remaining);
+            }
+        }
+    }, remaining);
+}
+
+void FrameGraph::Clear() {
+    tasks.clear();
+    built = false;
+}
+
+int FrameGraph::GetTaskCount() const {
+    return static_cast<int>(tasks.size());
+}
@@ -0,0 +1,57 @@
+#ifndef FRAMEGRAPH_H
+#define FRAMEGRAPH_H
+
+#include <SDL.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <vector>
+#include "JobSystem.h"
+
+// Shared game data a frame task may touch. Tasks declare what they read and
+// write; two tasks only run concurrently when neither writes what the other uses.
+enum FrameResource : Uint32 {
+    FRAME_RES_PLAYER         = 1u << 0,
+    FRAME_RES_PLAYER_BULLETS = 1u << 1,
+    FRAME_RES_ENEMY_BULLETS  = 1u << 2,
+    FRAME_RES_ENEMIES        = 1u << 3,
+    FRAME_RES_OBSTACLES      = 1u << 4,
+    FRAME_RES_ORBS           = 1u << 5,
+    FRAME_RES_STAGE          = 1u << 6,
+    FRAME_RES_GAME_STATE     = 1u << 7,
+    FRAME_RES_TIMERS         = 1u << 8,    // Game::timerWheel (scheduling, or cancelling by deleting an entity)
+    FRAME_RES_PATTERNS       = 1u << 9     // Game::bulletPatterns
+};
+
+// Per-frame task graph. Tasks are added in the order the sequential code would
+// run them; Build() orders every conflicting pair the same way and leaves the
+// rest free to run in parallel on the JobSystem.
+class FrameGraph {
+public:
+    FrameGraph();
+
+    int AddTask(const char* name, Uint32 reads, Uint32 writes, std::function<void()> body);
+    void Build();
+    void Execute(JobSystem& jobs);
+    void Clear();
+
+    int GetTaskCount() const;
+
+private:
+    struct FrameTask {
+        const char* name;
+        Uint32 reads;
+        Uint32 writes;
+        std::function<void()> body;
+        std::vector<int> successors;
+        int dependencyCount;
+        std::atomic<int> pending;
+    };
+
+    std::deque<FrameTask> tasks;
+    bool built;
+
+    void Dispatch(JobSystem& jobs, int index, JobCounter* remaining);
+};
+
+#endif
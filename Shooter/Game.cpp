@@ -2,22 +2,53 @@
 #include "Player.h"
 #include "Enemy.h"
 #include "Obstacle.h"
-#include "Orb.h"
 #include "Bullet.h"
+#include "SweptCollision.h"
 #include "StageManager.h"
+#include "FastMath.h"
 #include <vector>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <algorithm>
-
-Game::Game() : window(nullptr), renderer(nullptr), isRunning(false), player(nullptr),
-               lastEnemySpawnTime(0),
+#include <random>
+
+static const char* const CREDITS_TEXT[] = {
+    "GAME COMPLETE!",
+    "",
+    "A 2D Shooter Game",
+    "",
+    "--- CREDITS ---",
+    "Created By: [Ngo Minh Triet]",
+    "",
+    "Special Thanks:",
+    "SDL Libraries",
+    "Music: Chad Crouch| Charcoal",
+    "You (The Player!)",
+    "",
+    "",
+    "Thanks for Playing!"
+};
+static const int CREDITS_LINE_COUNT = sizeof(CREDITS_TEXT) / sizeof(CREDITS_TEXT[0]);
+
+static const int MENU_OPTION_COUNT = 3;   // Start Game, Horde Mode, Quit Game
+
+Game::Game() : window(nullptr), renderer(nullptr), isRunning(false),
+               lastEnemySpawnTime(0), spawnDue(true), gameSeed(0),
                currentState(GameState::MAIN_MENU),
+               player(nullptr),
+               enemyGrid(ENEMY_GRID_CELL_SIZE), obstacleGrid(OBSTACLE_GRID_CELL_SIZE),
                stageManager(),
+               frameArena(FRAME_ARENA_BYTES), renderArena(FRAME_ARENA_BYTES),
+               playerTex(nullptr), enemyTexNormal(nullptr), enemyTexFast(nullptr), enemyTexTank(nullptr),
+               enemyTexQuick(nullptr), enemyTexBoss(nullptr), neutralObstacleTexture(nullptr),
+               hostileObstacleTexture(nullptr), backgroundTexture(nullptr), orbTexture(nullptr),
+               menuBackgroundTexture(nullptr),
+               uiFont(nullptr), textColor({255, 255, 255, 255}), highlightColor({255, 255, 0, 255}),
                creditsScrollY(0), creditsStartTime(0),
                selectedMenuOption(0),
-               uiFont(nullptr), textColor({255, 255, 255, 255}), highlightColor({255, 255, 0, 255}) {}
+               showStats(false), simulationMs(0.0f), renderMs(0.0f), allocStats(),
+               renderThread(nullptr), renderReady(nullptr), renderRunning(false), renderInitOk(false) {}
 
 Game::~Game() {
     Clean();
@@ -56,29 +87,94 @@ bool Game::Init(const char* title, int xpos, int ypos, int width, int height, bo
         return false;
     }
 
-    // 5. Tao Renderer
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    if (!renderer) {
-        std::cerr << "SDL_CreateRenderer Error: " << SDL_GetError() << std::endl;
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+        std::cerr << "SDL_mixer could not initialize! Mix_Error: " << Mix_GetError() << std::endl;
+    } else {
+        std::cout << "SDL_mixer initialized successfully." << std::endl;
+        Mix_AllocateChannels(16);
+    }
+
+    // 5. Tao render thread (renderer, texture va phong chu duoc tao tren thread nay)
+    renderReady = SDL_CreateSemaphore(0);
+    renderRunning = true;
+    renderThread = SDL_CreateThread(RenderThreadMain, "RenderThread", this);
+    if (!renderThread) {
+        std::cerr << "SDL_CreateThread Error: " << SDL_GetError() << std::endl;
+        renderRunning = false;
         SDL_DestroyWindow(window);
+        window = nullptr;
         TTF_Quit();
         IMG_Quit();
         SDL_Quit();
         return false;
     }
-
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-        std::cerr << "SDL_mixer could not initialize! Mix_Error: " << Mix_GetError() << std::endl;
-    } else {
-        std::cout << "SDL_mixer initialized successfully." << std::endl;
-        Mix_AllocateChannels(16);
+    SDL_SemWait(renderReady);
+    if (!renderInitOk) {
+        return false;
     }
 
     // 6. Vi tri vien dan
     bulletRenderOffsetX = SCREEN_WIDTH / 2;
     bulletRenderOffsetY = SCREEN_HEIGHT / 2;
 
-    // 7. Load texture
+    if (!LoadSounds()) {
+        std::cerr << "FATAL ERROR: Failed to load required sounds. Cannot start game." << std::endl;
+        Clean();
+        return false;
+    }
+
+    // 10. So ngau nhien
+    gameSeed = static_cast<Uint32>(time(NULL));
+
+    // 11. Mat na va cham (collision masks); missing ones fall back to the shape tests
+    collisionMasks.Load();
+
+    // 12. Bang vu khi (weapon table); falls back to the built-in one
+    weapons.Load("assets/weapons.txt");
+
+    // 13. Khoi tao job system
+    jobSystem.Init(SDL_GetCPUCount() - 1);
+    chunkStreamer.Start();
+    BuildFrameGraph();
+
+    currentState = GameState::MAIN_MENU;
+    selectedMenuOption = 0;
+    isRunning = true;
+
+    if (backgroundMusic) {
+        if (Mix_PlayMusic(backgroundMusic, -1) == -1) {
+             std::cerr << "Mix_PlayMusic Error: " << Mix_GetError() << std::endl;
+        }
+        const float musicVolumePercentage = 0.20f; // 15%
+        int calculatedMusicVolume = static_cast<int>(MIX_MAX_VOLUME * musicVolumePercentage);
+        Mix_VolumeMusic(calculatedMusicVolume);
+    }
+    std::cout << "[DEBUG] Game::Init End - Success" << std::endl;
+    return true;
+}
+
+int Game::RenderThreadMain(void* data) {
+    Game* game = static_cast<Game*>(data);
+    game->renderInitOk = game->InitRenderer();
+    SDL_SemPost(game->renderReady);
+
+    if (game->renderInitOk) {
+        game->RunRenderLoop();
+    }
+    game->ReleaseRenderResources();
+    return 0;
+}
+
+// Runs on the render thread: the renderer and every texture belong to it
+bool Game::InitRenderer() {
+    // 1. Tao Renderer
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!renderer) {
+        std::cerr << "SDL_CreateRenderer Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    // 2. Load texture
     playerTex = IMG_LoadTexture(renderer, "assets/player1.png");
 
     bulletTexNormal = IMG_LoadTexture(renderer, "assets/bullet_normal.png");
@@ -101,50 +197,146 @@ bool Game::Init(const char* title, int xpos, int ypos, int width, int height, bo
 
     orbTexture = IMG_LoadTexture(renderer, "assets/orb.png");
 
-    if (!LoadSounds()) {
-        std::cerr << "FATAL ERROR: Failed to load required sounds. Cannot start game." << std::endl;
-        Clean();
-        return false;
-    }
-
-    // 8. Kiem tra load texture
+    // 3. Kiem tra load texture
     if (!playerTex || !neutralObstacleTexture || !hostileObstacleTexture || !backgroundTexture || !orbTexture) {
         std::cerr << "Failed to load one or more textures: " << IMG_GetError() << std::endl;
         return false;
     }
     if (backgroundTexture) { SDL_QueryTexture(backgroundTexture, NULL, NULL, &backgroundWidth, &backgroundHeight); }
 
-    // 9. Khoi tao phong chu
+    // 4. Khoi tao phong chu
     uiFont = TTF_OpenFont("assets/arial.ttf", 24);
     if (!uiFont) {
         std::cerr << "Warning: Failed to load font: assets/arial.ttf Error: " << TTF_GetError() << std::endl;
     }
     textColor = { 255, 255, 255, 255 };
+    return true;
+}
 
-    // 10. So ngau nhien
-    srand(static_cast<unsigned int>(time(NULL)));
+// Draws the newest snapshot whenever one is published. A slow present or
+// vsync wait only delays this loop, never the simulation ticks.
+void Game::RunRenderLoop() {
+    while (renderRunning) {
+        if (!renderBuffer.Acquire()) {
+            SDL_Delay(1);
+            continue;
+        }
+        Render(renderBuffer.Front());
+    }
+}
 
-    currentState = GameState::MAIN_MENU;
-    selectedMenuOption = 0;
-    isRunning = true;
+void Game::ReleaseRenderResources() {
+    // Destroy textures
+    if (playerTex) SDL_DestroyTexture(playerTex);
 
-    if (backgroundMusic) {
-        if (Mix_PlayMusic(backgroundMusic, -1) == -1) {
-             std::cerr << "Mix_PlayMusic Error: " << Mix_GetError() << std::endl;
-        }
-        const float musicVolumePercentage = 0.20f; // 15%
-        int calculatedMusicVolume = static_cast<int>(MIX_MAX_VOLUME * musicVolumePercentage);
-        Mix_VolumeMusic(calculatedMusicVolume);
+    if (bulletTexNormal) SDL_DestroyTexture(bulletTexNormal);
+    if (bulletTexPowered) SDL_DestroyTexture(bulletTexPowered);
+    if (bulletTexSuperPowered) SDL_DestroyTexture(bulletTexSuperPowered);
+
+    if (enemyTexNormal) SDL_DestroyTexture(enemyTexNormal);
+    if (enemyTexFast) SDL_DestroyTexture(enemyTexFast);
+    if (enemyTexTank) SDL_DestroyTexture(enemyTexTank);
+    if (enemyTexQuick) SDL_DestroyTexture(enemyTexQuick);
+    if (enemyTexBoss) SDL_DestroyTexture(enemyTexBoss);
+
+    if (neutralObstacleTexture) SDL_DestroyTexture(neutralObstacleTexture);
+    if (hostileObstacleTexture) SDL_DestroyTexture(hostileObstacleTexture);
+
+    if (backgroundTexture) SDL_DestroyTexture(backgroundTexture);
+    if (menuBackgroundTexture) SDL_DestroyTexture(menuBackgroundTexture);
+
+    if (orbTexture) SDL_DestroyTexture(orbTexture);
+
+    if (uiFont) {
+        TTF_CloseFont(uiFont);
+        uiFont = nullptr;
     }
-    std::cout << "[DEBUG] Game::Init End - Success" << std::endl;
-    return true;
+
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+        renderer = nullptr;
+    }
+}
+
+void Game::StopRenderThread() {
+    if (renderThread) {
+        renderRunning = false;
+        SDL_WaitThread(renderThread, nullptr);
+        renderThread = nullptr;
+    }
+    if (renderReady) {
+        SDL_DestroySemaphore(renderReady);
+        renderReady = nullptr;
+    }
+}
+
+// Copies what the renderer needs out of the live game objects
+void Game::PublishSnapshot() {
+    AllocScope allocScope(AllocTag::SNAPSHOT);
+    RenderSnapshot& snapshot = renderBuffer.BeginWrite();
+    snapshot.state = currentState;
+    snapshot.selectedMenuOption = selectedMenuOption;
+    snapshot.creditsStartTime = creditsStartTime;
+    snapshot.sprites.clear();
+    snapshot.hasPlayer = (player != nullptr);
+
+    if (player) {
+        snapshot.cameraX = player->x;
+        snapshot.cameraY = player->y;
+
+        // Appearance system: a position and an appearance are all it needs. Pickups are
+        // drawn under the enemies, anything with a velocity (the bullets) over them.
+        auto drawAppearance = [&](const Position& position, const Appearance& look, const auto&) {
+            if (look.alpha <= 0 || !look.texture) return;
+            SDL_Rect rect = {static_cast<int>(position.x - player->x + SCREEN_WIDTH / 2.0f - look.width / 2.0f),
+                             static_cast<int>(position.y - player->y + SCREEN_HEIGHT / 2.0f - look.height / 2.0f),
+                             look.width, look.height};
+            snapshot.AddSprite({look.texture, rect, 0.0, static_cast<Uint8>(look.alpha)});
+        };
+
+        for (auto obs : obstacles) { if(obs) obs->Render(snapshot, player); }
+        world.Each<Position, Appearance, Pickup>(drawAppearance);
+        for (auto enemy : enemies) { if(enemy) enemy->Render(snapshot, player); }
+        world.Each<Position, Appearance, Velocity>(drawAppearance);
+        bulletPatterns.Render(snapshot, player->x, player->y);
+        player->Render(snapshot);
+
+        snapshot.hud.health = player->health;
+        snapshot.hud.maxHealth = player->maxHealth;
+        snapshot.hud.experience = player->experience;
+        snapshot.hud.experienceToNextLevel = player->experienceToNextLevel;
+        snapshot.hud.level = player->level;
+    }
+    snapshot.hud.stageNumber = stageManager.GetCurrentStageNumber();
+    snapshot.hud.killCount = stageManager.GetCurrentKillCount();
+    snapshot.hud.killGoal = stageManager.GetCurrentKillGoal();
+
+    snapshot.stats.visible = showStats;
+    snapshot.stats.enemies = static_cast<int>(enemies.size());
+    snapshot.stats.playerBullets = world.Get<PlayerBulletArchetype>().GetCount();
+    snapshot.stats.enemyBullets = world.Get<EnemyBulletArchetype>().GetCount();
+    snapshot.stats.patternBullets = bulletPatterns.GetBulletCount();
+    snapshot.stats.volleys = static_cast<int>(bulletPatterns.volleys.size());
+    snapshot.stats.obstacles = static_cast<int>(obstacles.size());
+    snapshot.stats.turrets = obstacleRegistry.Count(ObstacleType::HOSTILE);
+    snapshot.stats.orbs = world.Get<OrbArchetype>().GetCount();
+    snapshot.stats.sprites = static_cast<int>(snapshot.sprites.size());
+    snapshot.stats.simulationMs = simulationMs;
+    snapshot.stats.arenaKB = static_cast<int>(frameArena.GetLastFrameBytes() / 1024);
+    snapshot.stats.arenaPeakKB = static_cast<int>(frameArena.GetPeakBytes() / 1024);
+    snapshot.stats.arenaOverflows = frameArena.GetLastFrameOverflows();
+    snapshot.stats.allocTracking = AllocTracker::IsEnabled();
+    snapshot.stats.heap = allocStats;
+
+    renderBuffer.Publish();
 }
 
 // Ham render van ban
-void Game::RenderText(const std::string& text, int x, int y, bool centered, SDL_Color color) {
-    if (!uiFont || text.empty()) return;
+void Game::RenderText(const char* text, int x, int y, bool centered, SDL_Color color) {
+    if (!uiFont || !text || !text[0]) return;
+    AllocScope allocScope(AllocTag::RENDER_TEXT);
 
-    SDL_Surface* textSurface = TTF_RenderText_Solid(uiFont, text.c_str(), color);
+    SDL_Surface* textSurface = TTF_RenderText_Solid(uiFont, text, color);
     if (!textSurface) { std::cerr << "TTF_RenderText Error: " << TTF_GetError() << std::endl; return; }
 
     SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
@@ -161,87 +353,100 @@ void Game::RenderText(const std::string& text, int x, int y, bool centered, SDL_
 }
 
 void Game::SpawnEnemy(int count) {
+    AllocScope allocScope(AllocTag::SPAWN);
     // Man choi
     const StageData& currentStage = stageManager.GetCurrentStageData();
     Uint32 spawnInterval = currentStage.spawnInterval; // Thoi gian 1 lan spawn
 
     Uint32 currentTime = SDL_GetTicks();
-    if (currentTime - lastEnemySpawnTime > spawnInterval)
+    if (!player) return;
+
+    // Scripted waves of the stage timeline
+    while (const WaveEvent* wave = stageManager.NextDueWave(currentTime)) {
+        for (int i = 0; i < wave->count; ++i) SpawnEnemyOfType(wave->type);
+    }
+
+    if (spawnDue)
     {
         int enemiesToSpawn = currentStage.baseSpawnCount; // So luong ke dich
+        int room = currentStage.enemyCap - static_cast<int>(enemies.size());
+        enemiesToSpawn = std::min(enemiesToSpawn, std::max(room, 0));
+
+        const SpawnTable& table = currentStage.spawnTable;
         for (int i = 0; i < enemiesToSpawn; ++i) {
-            // Vi tri spawn nguoi choi
-            float x = 0.0f, y = 0.0f;
-             if (!player) continue;
-             float spawnDist = std::max(SCREEN_WIDTH, SCREEN_HEIGHT) * 0.8f;
-             float angle = RandomFloat(0, 2 * M_PI);
-             x = player->x + cos(angle) * spawnDist;
-             y = player->y + sin(angle) * spawnDist;
-
-            // Chon cac loai ke dich
-            EnemyType enemyType = EnemyType::NORMAL;
-            int randVal = rand() % 1000;
-
-            // Kiem tra stage co spawn Boss khong
-            bool spawnBossAttempt = false;
-            if (currentStage.canSpawnBoss && randVal < currentStage.bossSpawnChance) {
-                 // Chi co 1 Boss tai 1 thoi diem
-                 bool bossExists = false;
-                 for(const auto& existingEnemy : enemies) {
-                     if(existingEnemy && existingEnemy->type == EnemyType::BOSS) {
-                         bossExists = true;
-                         break;
-                     }
-                 }
-                 if (!bossExists) {
-                      enemyType = EnemyType::BOSS;
-                      spawnBossAttempt = true;
-                 } else {
-                     // Neu khong thi spawn 1 con Tank
-                     enemyType = EnemyType::TANK;
-                 }
+            // Chon cac loai ke dich: one alias-table draw
+            int column = RandomInt(table.GetColumnCount());
+            float coin = RandomFloat(0.0f, 1.0f);
+            EnemyType enemyType = table.Sample(column, coin);
+
+            // Chi co 1 Boss tai 1 thoi diem, neu khong thi spawn 1 con Tank
+            if (enemyType == EnemyType::BOSS && enemyRegistry.Count(EnemyType::BOSS) > 0) {
+                enemyType = EnemyType::TANK;
             }
+            SpawnEnemyOfType(enemyType);
+        }
+        lastEnemySpawnTime = currentTime;
+        spawnDue = false;
+        spawnTimer = timerWheel.Schedule(currentTime + spawnInterval + 1, [this]() { spawnDue = true; });
+    }
+}
 
-            // Chon cac loai ke dich (Khong co Boss)
-            if (!spawnBossAttempt) {
-                 int cumulativeChance = 0;
-                 bool typeSet = false;
-                 for (const auto& pair : currentStage.spawnProbabilities) {
-                      cumulativeChance += pair.second;
-                      if (randVal < cumulativeChance) {
-                           enemyType = pair.first;
-                           typeSet = true;
-                           break;
-                      }
-                 }
-                 if (!typeSet) {
-                      enemyType = EnemyType::NORMAL;
-                 }
-            }
+// One enemy of 'enemyType' on a ring around the player
+void Game::SpawnEnemyOfType(EnemyType enemyType) {
+    // Vi tri spawn nguoi choi
+    float spawnDist = std::max(SCREEN_WIDTH, SCREEN_HEIGHT) * 0.8f;
+    float angle = RandomFloat(0, 2 * M_PI);
+    float spawnSin, spawnCos;
+    FastSinCos(angle, spawnSin, spawnCos);
+    float x = player->x + spawnCos * spawnDist;
+    float y = player->y + spawnSin * spawnDist;
+
+    // Chon texture
+    SDL_Texture* selectedEnemyTexture = nullptr;
+    SDL_Texture* selectedBulletTexture = nullptr;
+    switch (enemyType) {
+        case EnemyType::NORMAL: selectedEnemyTexture = enemyTexNormal; selectedBulletTexture = bulletTexNormal; break;
+        case EnemyType::FAST:   selectedEnemyTexture = enemyTexFast;   selectedBulletTexture = bulletTexPowered; break;
+        case EnemyType::TANK:   selectedEnemyTexture = enemyTexTank;   selectedBulletTexture = bulletTexSuperPowered; break;
+        case EnemyType::QUICK:  selectedEnemyTexture = enemyTexQuick;  selectedBulletTexture = bulletTexExtremePowered; break;
+        case EnemyType::BOSS:   selectedEnemyTexture = enemyTexBoss;   selectedBulletTexture = bulletTexBoss; break;
+    }
 
-            // Chon texture
-            SDL_Texture* selectedEnemyTexture = nullptr;
-            SDL_Texture* selectedBulletTexture = nullptr;
-            switch (enemyType) {
-                case EnemyType::NORMAL: selectedEnemyTexture = enemyTexNormal; selectedBulletTexture = bulletTexNormal; break;
-                case EnemyType::FAST:   selectedEnemyTexture = enemyTexFast;   selectedBulletTexture = bulletTexPowered; break;
-                case EnemyType::TANK:   selectedEnemyTexture = enemyTexTank;   selectedBulletTexture = bulletTexSuperPowered; break;
-                case EnemyType::QUICK:  selectedEnemyTexture = enemyTexQuick;  selectedBulletTexture = bulletTexExtremePowered; break;
-                case EnemyType::BOSS:   selectedEnemyTexture = enemyTexBoss;   selectedBulletTexture = bulletTexBoss; break;
-            }
+    // Tao ke dich
+    if (selectedEnemyTexture && selectedBulletTexture) {
+        enemies.push_back(new Enemy(x, y, selectedEnemyTexture, 100, 1.0f, 1.0f, this, enemyType, selectedBulletTexture));
+    }
+}
 
-            // Tao ke dich
-            if (selectedEnemyTexture && selectedBulletTexture) {
-                enemies.push_back(new Enemy(x, y, selectedEnemyTexture, player, 100, 1.0f, 1.0f, this, enemyType, selectedBulletTexture));
-            }
-        }
-        lastEnemySpawnTime = currentTime;
+// --- Random numbers ---
+// Each thread keeps its own generator and reseeds it whenever gameSeed changes.
+// The stream index tells the threads apart, so no two share a sequence.
+struct ThreadRandom {
+    std::mt19937 rng;
+    Uint32 seed = 0;
+    int stream = -1;
+};
+static thread_local ThreadRandom threadRandom;
+static std::atomic<int> nextRandomStream{0};
+
+static std::mt19937& ThreadRng(Uint32 gameSeed) {
+    ThreadRandom& state = threadRandom;
+    if (state.stream < 0 || state.seed != gameSeed) {
+        if (state.stream < 0) state.stream = nextRandomStream.fetch_add(1, std::memory_order_relaxed);
+        std::seed_seq seeds{gameSeed, static_cast<Uint32>(state.stream)};
+        state.rng.seed(seeds);
+        state.seed = gameSeed;
     }
+    return state.rng;
 }
 
 // Ham tao so ngau nhien
 float Game::RandomFloat(float min, float max) {
-    return min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (max - min)));
+    return std::uniform_real_distribution<float>(min, max)(ThreadRng(gameSeed));
+}
+
+int Game::RandomInt(int count) {
+    return std::uniform_int_distribution<int>(0, count - 1)(ThreadRng(gameSeed));
 }
 
 bool Game::LoadSounds() {
@@ -293,7 +498,7 @@ void Game::PlaySoundEffect(Mix_Chunk* sound) {
     }
 }
 
-void Game::StartNewGame() {
+void Game::StartNewGame(GameMode mode) {
     std::cout << "Starting New Game..." << std::endl;
     ResetGameData(); // Xoa du lieu game
 
@@ -310,11 +515,12 @@ void Game::StartNewGame() {
         player->level = 1;
         player->experience = 0;
         player->experienceToNextLevel = 50;
-        player->bulletType = BulletType::NORMAL;
-        player->shootingPattern = ShootingPattern::SINGLE;
         player->firingRateFactor = 4.0f;
+        player->SelectWeapon();
     }
-    stageManager.StartGame();
+    player->mask = collisionMasks.Acquire(MaskSprite::PLAYER, player->width, player->height);
+    stageManager.StartGame(mode);
+    showStats = (mode == GameMode::HORDE);
     if (stageManager.GetCurrentStageNumber() <= 0) { isRunning = false; return; }
 
     currentState = GameState::PLAYING;
@@ -330,11 +536,7 @@ void Game::StartNewGame() {
 void Game::ResetGameData() {
     std::cout << "Resetting game data..." << std::endl;
 
-    for (auto b : bullets) delete b;
-    bullets.clear();
-
-    for (auto eb : enemyBullets) delete eb;
-    enemyBullets.clear();
+    bulletPatterns.Clear();
 
     for (auto e : enemies) delete e;
     enemies.clear();
@@ -342,10 +544,15 @@ void Game::ResetGameData() {
     for (auto o : obstacles) delete o;
     obstacles.clear();
 
-    for (auto orb : orbs) delete orb;
-    orbs.clear();
+    world.Clear();
 
+    flowField.Invalidate();
+    lodScheduler.Reset();
+    timerWheel.Reset(SDL_GetTicks());
+    gameSeed = static_cast<Uint32>(ThreadRng(gameSeed)());   // new random streams and world layout each game
+    chunkStreamer.Reset(gameSeed);
     lastEnemySpawnTime = 0;
+    spawnDue = true;
 }
 
 void Game::ReturnToMenu() {
@@ -383,6 +590,14 @@ void Game::HandleEvents() {
         }
 
 
+        // F3: entity counts and timings
+        if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3) {
+             if (currentState == GameState::PLAYING || currentState == GameState::PAUSED) {
+                  showStats = !showStats;
+                  continue;
+             }
+        }
+
         // Cac phim chuc nang
         switch (currentState) {
             case GameState::MAIN_MENU: HandleMenuInput(event); break;
@@ -411,17 +626,19 @@ void Game::HandleMenuInput(SDL_Event& event) {
          switch(event.key.keysym.sym) {
              case SDLK_UP:
              case SDLK_w:
-                  selectedMenuOption = (selectedMenuOption - 1 + 2) % 2;
+                  selectedMenuOption = (selectedMenuOption - 1 + MENU_OPTION_COUNT) % MENU_OPTION_COUNT;
                   break;
              case SDLK_DOWN:
              case SDLK_s:
-                  selectedMenuOption = (selectedMenuOption + 1) % 2;
+                  selectedMenuOption = (selectedMenuOption + 1) % MENU_OPTION_COUNT;
                   break;
              case SDLK_RETURN:
              case SDLK_SPACE:
                   if (selectedMenuOption == 0) {
                        StartNewGame();
                   } else if (selectedMenuOption == 1) {
+                       StartNewGame(GameMode::HORDE);
+                  } else if (selectedMenuOption == 2) {
                        isRunning = false;
                   }
                   break;
@@ -434,7 +651,7 @@ void Game::HandleMenuInput(SDL_Event& event) {
 
 void Game::HandlePlayingInput(const Uint8* keystate) {
     if (player) {
-        player->HandleInput(keystate, bullets);
+        player->HandleInput(keystate);
     }
 }
 
@@ -480,13 +697,18 @@ void Game::HandleCreditsInput(SDL_Event& event) {
 
 void Game::Update() {
      if (!isRunning) return;
+     frameArena.Reset();
+     allocStats = AllocTracker::EndFrame();
 
      switch (currentState) {
          case GameState::MAIN_MENU:
              break;
-         case GameState::PLAYING:
+         case GameState::PLAYING: {
+             Uint64 start = SDL_GetPerformanceCounter();
              UpdatePlayingState();
+             simulationMs = static_cast<float>(SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
              break;
+         }
          case GameState::PAUSED:
              break;
          case GameState::GAME_OVER:
@@ -495,6 +717,8 @@ void Game::Update() {
              UpdateCreditsState();
              break;
      }
+
+     PublishSnapshot();
 }
 
 void Game::UpdatePlayingState() {
@@ -512,305 +736,434 @@ void Game::UpdatePlayingState() {
         }
     }
 
-    // --- 1. Despawn Out-of-Range Obstacles ---
-    for (auto it = obstacles.begin(); it != obstacles.end();) {
-        Obstacle* obs = *it;
-        float dx = obs->x - player->x;
-        float dy = obs->y - player->y;
-        float distance = std::sqrt(dx * dx + dy * dy);
-
-        if (distance > DESPAWN_RADIUS) {
-            delete obs;
-            it = obstacles.erase(it);
-        } else {
-            ++it;
-        }
+    // --- Fire due timers (they only set flags; the phases below act on them) ---
+    timerWheel.Advance(SDL_GetTicks());
+
+    // --- Simulation phases (see BuildFrameGraph) ---
+    frameGraph.Execute(jobSystem);
+    if (currentState != GameState::PLAYING) return;
+
+    SpawnEnemy(1);
+
+    if (stageManager.ShouldAdvanceStage()) {
+        player->LevelUp();
+        stageManager.AdvanceStage(player);
+         if (stageManager.IsGameWon()) {
+             currentState  = GameState::CREDITS;
+             creditsScrollY = SCREEN_HEIGHT;
+             creditsStartTime = SDL_GetTicks();
+         }
     }
-	// --- 2. Spawn New Obstacles (Up to MAX_OBSTACLES) ---
-    static std::vector<std::vector<bool>> obstacleGrid(NUM_GRID_CELLS, std::vector<bool>(NUM_GRID_CELLS, false));
-    static bool gridInitialized = false;
-
-    if (!gridInitialized) {
-        // Initialize the grid to all false (empty)
-        for (int i = 0; i < NUM_GRID_CELLS; ++i) {
-            for (int j = 0; j < NUM_GRID_CELLS; ++j) {
-                obstacleGrid[i][j] = false;
-            }
-        }
-        gridInitialized = true;
+}
+
+// Registers the UpdatePlayingState phases in their original order. Each phase
+// declares what it reads and writes so FrameGraph only serialises real conflicts;
+// phases that can end the game write FRAME_RES_GAME_STATE and later phases read it.
+void Game::BuildFrameGraph() {
+    frameGraph.Clear();
+    frameGraph.AddTask("ObstacleSpawning", FRAME_RES_PLAYER, FRAME_RES_OBSTACLES | FRAME_RES_TIMERS,
+                       [this]() { UpdateObstacleSpawning(); });
+    frameGraph.AddTask("IntegrateBullets", 0, FRAME_RES_PLAYER_BULLETS | FRAME_RES_ENEMY_BULLETS,
+                       [this]() { IntegrateBullets(); });
+    frameGraph.AddTask("PlayerBullets", FRAME_RES_PLAYER,
+                       FRAME_RES_PLAYER_BULLETS | FRAME_RES_ENEMIES | FRAME_RES_OBSTACLES | FRAME_RES_ORBS | FRAME_RES_STAGE |
+                       FRAME_RES_TIMERS,
+                       [this]() { UpdatePlayerBullets(); });
+    frameGraph.AddTask("EnemyBullets", FRAME_RES_OBSTACLES,
+                       FRAME_RES_PLAYER | FRAME_RES_ENEMY_BULLETS | FRAME_RES_OBSTACLES | FRAME_RES_GAME_STATE | FRAME_RES_TIMERS,
+                       [this]() { UpdateEnemyBullets(); });
+    frameGraph.AddTask("PatternBullets", FRAME_RES_OBSTACLES,
+                       FRAME_RES_PLAYER | FRAME_RES_PATTERNS | FRAME_RES_OBSTACLES | FRAME_RES_GAME_STATE | FRAME_RES_TIMERS,
+                       [this]() { UpdatePatternBullets(); });
+    frameGraph.AddTask("PlayerObstacles", FRAME_RES_OBSTACLES,
+                       FRAME_RES_PLAYER | FRAME_RES_GAME_STATE,
+                       [this]() { UpdatePlayerObstacleCollision(); });
+    frameGraph.AddTask("Enemies", FRAME_RES_PLAYER | FRAME_RES_OBSTACLES | FRAME_RES_GAME_STATE,
+                       FRAME_RES_ENEMIES | FRAME_RES_ENEMY_BULLETS | FRAME_RES_PATTERNS | FRAME_RES_TIMERS,
+                       [this]() { UpdateEnemies(); });
+    frameGraph.AddTask("Obstacles", FRAME_RES_PLAYER | FRAME_RES_GAME_STATE,
+                       FRAME_RES_OBSTACLES | FRAME_RES_ENEMY_BULLETS | FRAME_RES_TIMERS,
+                       [this]() { UpdateObstacles(); });
+    frameGraph.AddTask("OrbMotion", FRAME_RES_PLAYER | FRAME_RES_GAME_STATE, FRAME_RES_ORBS,
+                       [this]() { UpdateOrbMotion(); });
+    frameGraph.AddTask("OrbCollection", FRAME_RES_GAME_STATE, FRAME_RES_PLAYER | FRAME_RES_ORBS,
+                       [this]() { CollectOrbs(); });
+    frameGraph.Build();
+}
+
+void Game::UpdateObstacleSpawning() {
+    // Layouts generated in the background are taken in here, between ticks of the obstacle list
+    if (chunkStreamer.Update(player->x, player->y, player->vx, player->vy, chunkLoads, chunkUnloads)) {
+        StreamChunks();
     }
 
-    int attempts = 0;
-    while (obstacles.size() < MAX_OBSTACLES) {
-        // 1. Choose a random grid cell.
-        int gridX = rand() % NUM_GRID_CELLS;
-        int gridY = rand() % NUM_GRID_CELLS;
-
-        // 2. Check if the cell is occupied.
-        if (!obstacleGrid[gridX][gridY]) {
-            // 3. JITTER the cell's position.
-            float cellSize = (2.0f * SPAWN_RADIUS) / NUM_GRID_CELLS;
-            float cellX = player->x - SPAWN_RADIUS + gridX * cellSize;
-            float cellY = player->y - SPAWN_RADIUS + gridY * cellSize;
-
-            // Add a random offset *within* the cell size.
-            float jitterX = RandomFloat(-cellSize * 0.5f, cellSize * 0.5f);
-            float jitterY = RandomFloat(-cellSize * 0.5f, cellSize * 0.5f);
-
-            // 4. Calculate spawn position.  Apply the jitter.
-            float spawnX = cellX + jitterX;
-            float spawnY = cellY + jitterY;
-            float randSize = 50 + (rand() % 100); // Random size
-
-			// 5. Ensure minimum distance from *other* obstacles.
-            bool tooClose = false;
-            for (const auto& otherObs : obstacles) {
-                float dx = spawnX - otherObs->x;
-                float dy = spawnY - otherObs->y;
-                float dist = std::sqrt(dx * dx + dy * dy);
-                if (dist < MIN_SEPARATION_DISTANCE) {
-                    tooClose = true;
-                    break;
-                }
-            }
+    // Covered by FRAME_RES_OBSTACLES: the enemy and obstacle phases read it
+    lineOfSight.Rebuild(player->x, player->y, obstacles);
+    RebuildObstacleGrid();
+}
 
-			if (!tooClose)
-			{
-				// 6. Determine obstacle type and texture
-                ObstacleType type = (rand() % 100 < 90) ? ObstacleType::NEUTRAL : ObstacleType::HOSTILE;
-                SDL_Texture* tex = (type == ObstacleType::NEUTRAL) ? neutralObstacleTexture : hostileObstacleTexture;
-                SDL_Texture* obsBulletTex = nullptr;
-                int obstacleHealth = 0;
-                if (type == ObstacleType::NEUTRAL) {
-                    tex = neutralObstacleTexture;
-                    obstacleHealth = 99999;
-                } else {
-                    tex = hostileObstacleTexture;
-                    obstacleHealth = 150;
-                    obsBulletTex = bulletTexNormal;
-                }
+// Obstacles only hover and turn between rebuilds, so the half diagonal covers them wherever they face
+void Game::RebuildObstacleGrid() {
+    obstacleGrid.Clear();
+    for (int i = 0; i < static_cast<int>(obstacles.size()); ++i) {
+        Obstacle* obstacle = obstacles[i];
+        if (!obstacle) continue;
+        float halfDiagonal = 0.5f * std::sqrt(static_cast<float>(obstacle->width * obstacle->width + obstacle->height * obstacle->height));
+        obstacleGrid.Insert(i, obstacle->x + obstacle->width / 2.0f, obstacle->y + obstacle->height / 2.0f, halfDiagonal);
+    }
+    obstacleGrid.Build();
+}
 
-				// 7. Mark the grid cell as occupied.
-                obstacleGrid[gridX][gridY] = true;
-
-				// 8. Spawn the obstacle
-                obstacles.push_back(new Obstacle(spawnX, spawnY, randSize, randSize, tex, type, obstacleHealth, obsBulletTex));
-                attempts = 0;
-			}
-			else
-			{
-                attempts++;
-                if (attempts > 100) {
-                    return;
-                }
-			}
-        }
-        else {
-            attempts++;
-            if (attempts > 100) {
-                return;
+// The bullet phases null out the obstacles they destroy, so the grid's ids stay
+// valid until the phase ends; this drops the holes and re-indexes the grid
+void Game::CompactObstacles() {
+    auto end = std::remove(obstacles.begin(), obstacles.end(), nullptr);
+    if (end == obstacles.end()) return;
+    obstacles.erase(end, obstacles.end());
+    RebuildObstacleGrid();
+}
+
+void Game::StreamChunks() {
+    AllocScope allocScope(AllocTag::STREAMING);
+    // --- 1. Drop the obstacles of chunks that went out of range ---
+    for (Sint64 key : chunkUnloads) {
+        for (auto it = obstacles.begin(); it != obstacles.end();) {
+            Obstacle* obs = *it;
+            if (obs->chunkIndex >= 0 && obs->chunkKey == key) {
+                delete obs;
+                it = obstacles.erase(it);
+            } else {
+                ++it;
             }
         }
     }
 
-	// --- Clear the grid for the next frame ---
-    for (int i = 0; i < NUM_GRID_CELLS; ++i) {
-        for (int j = 0; j < NUM_GRID_CELLS; ++j) {
-            obstacleGrid[i][j] = false;
+    // --- 2. Build the obstacles of newly loaded chunks ---
+    for (const ChunkLayout& layout : chunkLoads) {
+        for (const ObstacleSpawn& spawn : layout.obstacles) {
+            SDL_Texture* tex = nullptr;
+            SDL_Texture* obsBulletTex = nullptr;
+            int obstacleHealth = 0;
+            if (spawn.type == ObstacleType::NEUTRAL) {
+                tex = neutralObstacleTexture;
+                obstacleHealth = 99999;
+            } else {
+                tex = hostileObstacleTexture;
+                obstacleHealth = 150;
+                obsBulletTex = bulletTexNormal;
+            }
+
+            Obstacle* obs = new Obstacle(spawn.x, spawn.y, spawn.size, spawn.size, tex, spawn.type, obstacleHealth, obsBulletTex);
+            obs->chunkKey = layout.key;
+            obs->chunkIndex = spawn.index;
+            obs->mask = collisionMasks.Acquire(spawn.type == ObstacleType::NEUTRAL ? MaskSprite::OBSTACLE_NEUTRAL : MaskSprite::OBSTACLE_HOSTILE,
+                                               obs->width, obs->height);
+            obstacles.push_back(obs);
+            obstacleRegistry.Add(obs);
+            obs->registry = &obstacleRegistry;
         }
     }
+}
 
-    SDL_Rect playerRect = { static_cast<int>(player->x), static_cast<int>(player->y), player->width, player->height };
-    const float maxDist = std::max(SCREEN_WIDTH, SCREEN_HEIGHT) * 1.5f;
+// Movement system: every entity with a velocity, over contiguous columns
+void Game::IntegrateBullets() {
+    world.Each<Position, PrevPosition, Velocity>([](Position& position, PrevPosition& previous, const Velocity& velocity) {
+        previous = {position.x, position.y};
+        position.x += velocity.x;
+        position.y += velocity.y;
+    });
+}
 
-    // --- Player Bullets vs. Enemies and Obstacles---
-     for (auto itB = bullets.begin(); itB != bullets.end();) {
-        Bullet* bullet = *itB;
-        if (!bullet) { itB = bullets.erase(itB); continue; } // Safety check
+// Circle around everything a bullet covered this tick, for the grid queries
+static void PathBounds(const PrevPosition& from, const Position& to, float bulletRadius, float& centerX, float& centerY, float& radius) {
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    centerX = from.x + dx * 0.5f;
+    centerY = from.y + dy * 0.5f;
+    radius = 0.5f * std::sqrt(dx * dx + dy * dy) + bulletRadius;
+}
 
-        bullet->Update();
-        bool bulletRemoved = false;
+void Game::UpdatePlayerBullets() {
+    const float maxDist = std::max(SCREEN_WIDTH, SCREEN_HEIGHT) * 1.5f;
 
-        if (std::abs(bullet->x - player->x) > maxDist || std::abs(bullet->y - player->y) > maxDist){
-           bullet->active = false;
-        }
+    // Broadphase over the enemies where they stand now; ids are indices into 'enemies'.
+    // The half diagonal also covers the boss's turning box.
+    enemyGrid.Clear();
+    for (int i = 0; i < static_cast<int>(enemies.size()); ++i) {
+        Enemy* enemy = enemies[i];
+        float halfDiagonal = 0.5f * std::sqrt(static_cast<float>(enemy->width * enemy->width + enemy->height * enemy->height));
+        enemyGrid.Insert(i, enemy->GetX() + enemy->width / 2.0f, enemy->GetY() + enemy->height / 2.0f, halfDiagonal);
+    }
+    enemyGrid.Build();
 
-        if(bullet->active) {
-            // Check vs Enemies
-            for (auto itE = enemies.begin(); itE != enemies.end();) {
-                Enemy* enemy = *itE; if (!enemy){ itE = enemies.erase(itE); continue; }
-                SDL_Rect enemyRect = {static_cast<int>(enemy->x), static_cast<int>(enemy->y), enemy->width, enemy->height};
-                SDL_Rect bulletRect = {static_cast<int>(bullet->x - bullet->width/2.0f), static_cast<int>(bullet->y - bullet->height/2.0f), bullet->width, bullet->height}; // Use centered rect
-
-                if (SDL_HasIntersection(&bulletRect, &enemyRect)) {
-                    enemy->health -= bullet->damage;
-                    if (enemy->health <= 0) {
-                        stageManager.RecordKill();
-                        PlaySoundEffect(enemyDeathSound);
-                        if (orbTexture) {
-                             int orbXp = 10; int orbSize = 15;
-                             switch (enemy->type) {
-                                case EnemyType::NORMAL: orbXp = 10; orbSize = 15; break;
-                                case EnemyType::FAST: orbXp = 15; orbSize = 20; break;
-                                case EnemyType::QUICK: orbXp = 20; orbSize = 25; break;
-                                case EnemyType::TANK: orbXp = 50; orbSize = 30; break;
-                                case EnemyType::BOSS: orbXp = 500; orbSize = 40; break;
-                             }
-                             orbs.push_back(new Orb(enemy->x + enemy->width / 2.0f, enemy->y + enemy->height / 2.0f, orbTexture, orbSize, orbXp));
-                        }
-                        delete enemy;
-                        itE = enemies.erase(itE);
-                    } else { ++itE; }
-                    bullet->active = false;
-                    bulletRemoved = true;
-                } else { ++itE; }
+    // --- Player Bullets vs. Enemies and Obstacles---
+    world.Get<PlayerBulletArchetype>().DestroyIf<Position, PrevPosition, Appearance, Damage>(
+        [&](const Position& position, const PrevPosition& previous, const Appearance& look, const Damage& damage) {
+        if (std::abs(position.x - player->x) > maxDist || std::abs(position.y - player->y) > maxDist) return true;
+
+        // Earliest contact along this tick's path, so a fast bullet neither skips a thin
+        // target nor hits one that is behind its first target: grid cells first, then the
+        // swept shape, then the sprite mask where there is one. Ties go to the lowest index,
+        // enemies before obstacles, as the full scan did, whatever order the grid returns.
+        float bulletRadius = look.width / 2.0f;
+        float pathX, pathY, pathRadius;
+        PathBounds(previous, position, bulletRadius, pathX, pathY, pathRadius);
+        float firstHit = 2.0f;
+        int hitEnemy = -1;
+        int hitObstacle = -1;
+
+        gridHits.clear();
+        enemyGrid.Query(pathX, pathY, pathRadius, gridHits);
+        for (int id : gridHits) {
+            Enemy* enemy = enemies[id];
+            if (!enemy) continue;   // killed earlier this tick
+            float hitTime;
+            if (SweepCircle(previous.x, previous.y, position.x, position.y, bulletRadius, enemy->GetShape(), hitTime) && hitTime <= firstHit &&
+                PathTouchesSprite(previous.x, previous.y, position.x, position.y, look.width, enemy->mask,
+                                  enemy->GetX() + enemy->width / 2.0f, enemy->GetY() + enemy->height / 2.0f,
+                                  enemyStore.dirX[enemy->slot], enemyStore.dirY[enemy->slot], hitTime) &&
+                (hitTime < firstHit || id < hitEnemy)) {
+                firstHit = hitTime;
+                hitEnemy = id;
             }
+        }
+        gridHits.clear();
+        obstacleGrid.Query(pathX, pathY, pathRadius, gridHits);
+        for (int id : gridHits) {
+            Obstacle* obstacle = obstacles[id];
+            if (!obstacle) continue;
+            float hitTime;
+            if (SweepCircle(previous.x, previous.y, position.x, position.y, bulletRadius, obstacle->GetShape(), hitTime) && hitTime <= firstHit &&
+                PathTouchesSprite(previous.x, previous.y, position.x, position.y, look.width, obstacle->mask,
+                                  obstacle->x + obstacle->width / 2.0f, obstacle->y + obstacle->height / 2.0f,
+                                  obstacle->dirX, obstacle->dirY, hitTime) &&
+                (hitTime < firstHit || (hitEnemy < 0 && id < hitObstacle))) {
+                firstHit = hitTime;
+                hitObstacle = id;
+                hitEnemy = -1;
+            }
+        }
 
-            // Check vs Obstacles
-            if (!bulletRemoved) {
-                for (auto itO = obstacles.begin(); itO != obstacles.end();) {
-                    Obstacle* obstacle = *itO; if (!obstacle) { itO = obstacles.erase(itO); continue; }
-                    // Use GetRect
-                    SDL_Rect obstacleRect = obstacle->GetRect();
-                    SDL_Rect bulletRect = {static_cast<int>(bullet->x - bullet->width/2.0f), static_cast<int>(bullet->y - bullet->height/2.0f), bullet->width, bullet->height};
-
-                    if (SDL_HasIntersection(&bulletRect, &obstacleRect)) {
-                        obstacle->TakeDamage(bullet->damage);
-                        bullet->active = false;
-                        bulletRemoved = true;
-
-                        if (obstacle->health <= 0 && obstacle->type != ObstacleType::NEUTRAL) {
-                            PlaySoundEffect(enemyDeathSound);
-                            delete obstacle;
-                            itO = obstacles.erase(itO);
-                        } else {
-                            ++itO;
-                        }
-                    } else {
-                        ++itO;
-                    }
+        if (hitEnemy >= 0) {
+            Enemy* enemy = enemies[hitEnemy];
+            enemy->health -= damage.amount;
+            if (enemy->health <= 0) {
+                stageManager.RecordKill();
+                PlaySoundEffect(enemyDeathSound);
+                if (orbTexture) {
+                     int orbXp = 10; int orbSize = 15;
+                     switch (enemy->type) {
+                        case EnemyType::NORMAL: orbXp = 10; orbSize = 15; break;
+                        case EnemyType::FAST: orbXp = 15; orbSize = 20; break;
+                        case EnemyType::QUICK: orbXp = 20; orbSize = 25; break;
+                        case EnemyType::TANK: orbXp = 50; orbSize = 30; break;
+                        case EnemyType::BOSS: orbXp = 500; orbSize = 40; break;
+                     }
+                     SpawnOrb(enemy->GetX() + enemy->width / 2.0f, enemy->GetY() + enemy->height / 2.0f, orbSize, orbXp);
                 }
+                delete enemy;
+                enemies[hitEnemy] = nullptr;   // keeps the grid ids valid; dropped below
             }
+            return true;
         }
-
-        if (!bullet->active) {
-            delete bullet;
-            itB = bullets.erase(itB);
-        } else {
-            ++itB;
+        if (hitObstacle >= 0) {
+            Obstacle* obstacle = obstacles[hitObstacle];
+            obstacle->TakeDamage(damage.amount);
+
+            if (obstacle->health <= 0 && obstacle->type != ObstacleType::NEUTRAL) {
+                PlaySoundEffect(enemyDeathSound);
+                if (obstacle->chunkIndex >= 0) chunkStreamer.MarkDestroyed(obstacle->chunkKey, obstacle->chunkIndex);
+                delete obstacle;
+                obstacles[hitObstacle] = nullptr;
+            }
+            return true;
         }
-    }
+        return false;
+    });
+
+    enemies.erase(std::remove(enemies.begin(), enemies.end(), nullptr), enemies.end());
+    CompactObstacles();
+}
+
+// Narrowphase after a shape hit at hitTime: walks the rest of the path against the
+// sprite's pixel mask and moves hitTime to the first opaque pixel. No mask, no change.
+bool Game::PathTouchesSprite(float fromX, float fromY, float toX, float toY, int diameter, const CollisionMask* mask,
+                             float centerX, float centerY, float dirX, float dirY, float& hitTime) {
+    if (!mask) return true;
+    const CollisionMask* probe = collisionMasks.AcquireDisc(diameter);
+    if (!probe) return true;
+    return SweepMask(*probe, fromX, fromY, toX, toY, hitTime, *mask, centerX, centerY, dirX, dirY, hitTime);
+}
+
+void Game::UpdateEnemyBullets() {
+    Circle playerShape = player->GetShape();
+    const float maxDist = std::max(SCREEN_WIDTH, SCREEN_HEIGHT) * 1.5f;
 
     // --- Enemy Bullets vs. Player AND Obstacle ---
-    for (auto it = enemyBullets.begin(); it != enemyBullets.end();) {
-        Bullet* bullet = *it;
-        if (!bullet) {
-            it = enemyBullets.erase(it); continue;
+    bool gameOver = false;
+    world.Get<EnemyBulletArchetype>().DestroyIf<Position, PrevPosition, Appearance, Damage>(
+        [&](const Position& position, const PrevPosition& previous, const Appearance& look, const Damage& damage) {
+        if (gameOver) return false;     // the game ended on an earlier bullet; leave the rest
+        if (std::abs(position.x - player->x) > maxDist || std::abs(position.y - player->y) > maxDist) return true;
+
+        // Earliest contact along this tick's path: the player, or an obstacle shielding them
+        float bulletRadius = look.width / 2.0f;
+        float firstHit = 2.0f;
+        bool hitPlayer = false;
+        int hitObstacle = -1;
+        float hitTime;
+        if (SweepCircle(previous.x, previous.y, position.x, position.y, bulletRadius, playerShape, hitTime) &&
+            PathTouchesSprite(previous.x, previous.y, position.x, position.y, look.width, player->mask,
+                              playerShape.x, playerShape.y, player->dirX, player->dirY, hitTime)) {
+            firstHit = hitTime;
+            hitPlayer = true;
+        }
+        float pathX, pathY, pathRadius;
+        PathBounds(previous, position, bulletRadius, pathX, pathY, pathRadius);
+        gridHits.clear();
+        obstacleGrid.Query(pathX, pathY, pathRadius, gridHits);
+        for (int id : gridHits) {
+            Obstacle* obstacle = obstacles[id];
+            if (!obstacle) continue;
+            if (SweepCircle(previous.x, previous.y, position.x, position.y, bulletRadius, obstacle->GetShape(), hitTime) && hitTime <= firstHit &&
+                PathTouchesSprite(previous.x, previous.y, position.x, position.y, look.width, obstacle->mask,
+                                  obstacle->x + obstacle->width / 2.0f, obstacle->y + obstacle->height / 2.0f,
+                                  obstacle->dirX, obstacle->dirY, hitTime) &&
+                (hitTime < firstHit || (!hitPlayer && id < hitObstacle))) {
+                firstHit = hitTime;
+                hitObstacle = id;
+                hitPlayer = false;
+            }
         }
 
-        bullet->Update();
-        bool bulletRemoved  = false;
-
-        // Check Bounds
-        if (std::abs(bullet->x - player->x) > maxDist || std::abs(bullet->y - player->y) > maxDist) {
-            bulletRemoved  = true;
-        } else {
-            // Check vs Player
-            SDL_Rect bulletRect = {static_cast<int>(bullet->x - bullet->width/2.0f), static_cast<int>(bullet->y - bullet->height/2.0f), bullet->width, bullet->height};
-            if (SDL_HasIntersection(&bulletRect, &playerRect)) {
-                player->TakeDamage(bullet->damage);
-                if (player->health <= 0) {
-                    currentState = GameState::GAME_OVER;
-                    PlaySoundEffect(playerDeathSound);
+        if (hitPlayer) {
+            player->TakeDamage(damage.amount);
+            if (player->health <= 0) {
+                currentState = GameState::GAME_OVER;
+                PlaySoundEffect(playerDeathSound);
                 Mix_HaltMusic();
-                delete bullet;
-                it = enemyBullets.erase(it);
-                return;
+                gameOver = true;
+            }
+            return true;
+        }
+        if (hitObstacle >= 0) {
+            Obstacle* obstacle = obstacles[hitObstacle];
+            if (obstacle->type != ObstacleType::HOSTILE) {
+                obstacle->TakeDamage(damage.amount);
+                if (obstacle->health <= 0) {
+                     PlaySoundEffect(enemyDeathSound);
+                     if (obstacle->chunkIndex >= 0) chunkStreamer.MarkDestroyed(obstacle->chunkKey, obstacle->chunkIndex);
+                     delete obstacle;
+                     obstacles[hitObstacle] = nullptr;
                 }
-                bulletRemoved  = true;
             }
+            return true;
+        }
+        return false;
+    });
+    CompactObstacles();
+}
 
-            if (!bulletRemoved) {
-                for (auto itO = obstacles.begin(); itO != obstacles.end();) {
-                     Obstacle* obstacle = *itO;
-                     if (!obstacle) { itO = obstacles.erase(itO); continue; }
-
-                     SDL_Rect obstacleRect = obstacle->GetRect();
-                     if (SDL_HasIntersection(&bulletRect, &obstacleRect)) {
-                         bulletRemoved = true;
-                         if (obstacle->type != ObstacleType::HOSTILE) {
-                             obstacle->TakeDamage(bullet->damage);
-                             if (obstacle->health <= 0) {
-                                  PlaySoundEffect(enemyDeathSound);
-                                  delete obstacle;
-                                  itO = obstacles.erase(itO);
-                             } else {
-                                  ++itO;
-                             }
-                         } else {
-                             ++itO;
-                         }
-                         break;
-                     } else {
-                         ++itO;
-                     }
-                 }
-             }
-         }
+// Pattern volleys vs. the player and obstacles. A volley is skipped whole
+// unless its ring of lanes passes near the target this tick; only then are
+// the live lanes swept from last tick's position to this one.
+void Game::UpdatePatternBullets() {
+    const float maxDist = std::max(SCREEN_WIDTH, SCREEN_HEIGHT) * 1.5f;
+    bulletPatterns.Advance(maxDist);
+
+    Circle playerShape = player->GetShape();
+    FrameVector<Obstacle*> nearObstacles{ArenaAllocator<Obstacle*>(&frameArena)};
+    nearObstacles.reserve(obstacles.size());
+    for (int v = 0; v < static_cast<int>(bulletPatterns.volleys.size()); ++v) {
+        PatternVolley& volley = bulletPatterns.volleys[v];
+        float radius = volley.diameter / 2.0f;
+        bool nearPlayer = volley.MayReach(playerShape.x, playerShape.y, playerShape.radius + radius);
+
+        nearObstacles.clear();
+        for (auto obstacle : obstacles) {
+            if (!obstacle) continue;
+            float halfDiagonal = 0.5f * std::sqrt(static_cast<float>(obstacle->width * obstacle->width + obstacle->height * obstacle->height));
+            if (volley.MayReach(obstacle->x + obstacle->width / 2.0f, obstacle->y + obstacle->height / 2.0f, halfDiagonal + radius)) {
+                nearObstacles.push_back(obstacle);
+            }
+        }
+        if (!nearPlayer && nearObstacles.empty()) continue;
+
+        float previous = static_cast<float>(volley.age - 1);
+        float current = static_cast<float>(volley.age);
+        for (int lane = 0; lane < volley.params.count; ++lane) {
+            if (!(volley.alive & (Uint64(1) << lane))) continue;
+            float fromX, fromY, toX, toY;
+            volley.LanePosition(lane, previous, fromX, fromY);
+            volley.LanePosition(lane, current, toX, toY);
+
+            // Earliest contact, as for bullet entities: the player, or an obstacle shielding them
+            float firstHit = 2.0f;
+            bool hitPlayer = false;
+            Obstacle* hitObstacle = nullptr;
+            float hitTime;
+            if (nearPlayer && SweepCircle(fromX, fromY, toX, toY, radius, playerShape, hitTime) &&
+                PathTouchesSprite(fromX, fromY, toX, toY, volley.diameter, player->mask, playerShape.x, playerShape.y,
+                                  player->dirX, player->dirY, hitTime)) {
+                firstHit = hitTime;
+                hitPlayer = true;
+            }
+            for (auto obstacle : nearObstacles) {
+                if (SweepCircle(fromX, fromY, toX, toY, radius, obstacle->GetShape(), hitTime) && hitTime < firstHit &&
+                    PathTouchesSprite(fromX, fromY, toX, toY, volley.diameter, obstacle->mask,
+                                      obstacle->x + obstacle->width / 2.0f, obstacle->y + obstacle->height / 2.0f,
+                                      obstacle->dirX, obstacle->dirY, hitTime)) {
+                    firstHit = hitTime;
+                    hitObstacle = obstacle;
+                    hitPlayer = false;
+                }
+            }
 
-        // Cleanup
-        if (bulletRemoved) {
-            delete bullet;
-            it = enemyBullets.erase(it);
-        } else {
-            ++it;
+            if (hitPlayer) {
+                bulletPatterns.Kill(v, lane);
+                player->TakeDamage(volley.damage);
+                if (player->health <= 0) {
+                    currentState = GameState::GAME_OVER;
+                    PlaySoundEffect(playerDeathSound);
+                    Mix_HaltMusic();
+                    CompactObstacles();
+                    return;
+                }
+            } else if (hitObstacle) {
+                bulletPatterns.Kill(v, lane);
+                if (hitObstacle->type != ObstacleType::HOSTILE) {
+                    hitObstacle->TakeDamage(volley.damage);
+                    if (hitObstacle->health <= 0) {
+                        PlaySoundEffect(enemyDeathSound);
+                        if (hitObstacle->chunkIndex >= 0) chunkStreamer.MarkDestroyed(hitObstacle->chunkKey, hitObstacle->chunkIndex);
+                        *std::find(obstacles.begin(), obstacles.end(), hitObstacle) = nullptr;
+                        nearObstacles.erase(std::find(nearObstacles.begin(), nearObstacles.end(), hitObstacle));
+                        delete hitObstacle;
+                    }
+                }
+            }
         }
     }
+    CompactObstacles();
+}
+
+void Game::UpdatePlayerObstacleCollision() {
+    if (currentState != GameState::PLAYING) return;
 
     // --- Player vs. Obstacles (Collision) ---
-    playerRect = { (int)player->x, (int)player->y, player->width, player->height };
     Uint32 currentTimeForObsDamage = SDL_GetTicks();
     static Uint32 lastObstacleDamageTime = 0;
     const Uint32 OBSTACLE_DAMAGE_COOLDOWN = 1000;
 
     for (auto itO = obstacles.begin(); itO != obstacles.end();) {
         Obstacle* obstacle = *itO;
-        SDL_Rect obstacleRect = obstacle->GetRect();
-        if (SDL_HasIntersection(&playerRect, &obstacleRect))
+        float pushX, pushY;
+        if (PushOut(player->GetShape(), obstacle->GetShape(), pushX, pushY))
         {
-            //Calculate overlap in x and y direction
-            int overlapX = 0;
-            int overlapY = 0;
-
-            //Right side
-            if (player->x < obstacle->x)
-            {
-                overlapX = playerRect.x + playerRect.w - obstacleRect.x;
-            }
-            else // Left Side
-            {
-                overlapX = -(obstacleRect.x + obstacleRect.w - playerRect.x);
-            }
-
-            //Down
-            if(player->y < obstacle->y)
-            {
-                overlapY = playerRect.y + playerRect.h - obstacleRect.y;
-            }
-            else// Up
-            {
-                overlapY = -(obstacleRect.y + obstacleRect.h - playerRect.y);
-            }
+            // Move the player out along the shortest way
+            player->x += pushX;
+            player->y += pushY;
 
-            // Move the player by the smallest overlap
-            if(abs(overlapX) < abs(overlapY))
-            {
-                player->x -= overlapX;
-            }
-            else
-            {
-                player->y -= overlapY;
-            }
             // Hostile Damage
             if (obstacle->type == ObstacleType::HOSTILE) {
                  if (currentTimeForObsDamage - lastObstacleDamageTime > OBSTACLE_DAMAGE_COOLDOWN) {
@@ -827,92 +1180,174 @@ void Game::UpdatePlayingState() {
         }
          ++itO;
     }
+}
 
-    // --- Update Enemies ---
+void Game::UpdateEnemies() {
+    if (currentState != GameState::PLAYING) return;
+
+    Uint32 currentTime = SDL_GetTicks();
+    const float maxForce = 0.3f;
+
+    flowField.Update(player->x, player->y, obstacles);
+    lodScheduler.Schedule(enemies, enemyStore, player->x, player->y);
+
+    // Decide (per enemy, branchy), add separation, steer (all enemies, SIMD), then move and shoot.
+    // Enemies the LOD scheduler skipped this tick just coast on their last velocity.
     for (auto& enemy : enemies) {
-        enemy->Update(enemies, obstacles, enemyBullets, player, this);
+        if (enemyStore.active[enemy->slot]) enemy->Think(player, currentTime);
+        else enemy->HoldCourse();
     }
+    ApplySeparation(enemyStore, enemyGrid, ENEMY_SEPARATION_WEIGHT, ENEMY_SEPARATION_PADDING);
+    SteerEnemies(enemyStore, maxForce);
 
-    // --- Update Obstacles ---
-    for (auto& obstacle : obstacles) {
-        obstacle->Update(player, enemyBullets, this);
+    // Enemies that would fire ask whether the player is visible; a bounded number of rays per tick
+    float playerCenterX = player->x + player->width / 2.0f;
+    float playerCenterY = player->y + player->height / 2.0f;
+    enemyLos.Clear();
+    for (auto& enemy : enemies) {
+        if (!enemyStore.active[enemy->slot] || !enemy->WantsToShoot()) continue;
+        float halfSize = std::max(enemy->width, enemy->height) * 0.5f;
+        enemyLos.Add(enemy->GetX() + enemy->width / 2.0f, enemy->GetY() + enemy->height / 2.0f, playerCenterX, playerCenterY,
+                     halfSize, player->width / 2.0f, &enemy->clearShot);
     }
+    enemyLos.Resolve(lineOfSight, LOS_QUERY_BUDGET);
 
-    // --- Update Orbs ---
-    playerRect = { static_cast<int>(player->x), static_cast<int>(player->y), player->width, player->height }; // Update player rect again
-    const float MAGNET_RADIUS_SQ = ORB_MAGNET_RADIUS * ORB_MAGNET_RADIUS;
+    for (auto& enemy : enemies) {
+        if (enemyStore.active[enemy->slot]) enemy->Move(obstacles, currentTime);
+        else enemy->Coast();
+    }
+}
 
-    for (auto it = orbs.begin(); it != orbs.end(); /* manual increment */) {
-        Orb* orb = *it;
-        if (!orb) { it = orbs.erase(it); continue; }
+void Game::UpdateObstacles() {
+    if (currentState != GameState::PLAYING) return;
+
+    // Turrets in range ask whether the player is visible, skipping their own cells
+    const float shootRangeSq = 700.0f * 700.0f;
+    float playerCenterX = player->x + player->width / 2.0f;
+    float playerCenterY = player->y + player->height / 2.0f;
+    const std::vector<Obstacle*>& turrets = obstacleRegistry.Of(ObstacleType::HOSTILE);
+    turretLos.Clear();
+    for (Obstacle* obstacle : turrets) {
+        float centerX = obstacle->x + obstacle->width / 2.0f;
+        float centerY = obstacle->y + obstacle->height / 2.0f;
+        float dx = playerCenterX - centerX;
+        float dy = playerCenterY - centerY;
+        if (dx * dx + dy * dy >= shootRangeSq) continue;
+        float halfDiagonal = 0.5f * std::sqrt(static_cast<float>(obstacle->width * obstacle->width + obstacle->height * obstacle->height));
+        turretLos.Add(centerX, centerY, playerCenterX, playerCenterY, halfDiagonal, player->width / 2.0f, &obstacle->clearShot);
+    }
+    turretLos.Resolve(lineOfSight, LOS_QUERY_BUDGET);
 
-        orb->Update(); // Update fading
+    // One loop per type, no per-obstacle dispatch
+    for (Obstacle* obstacle : turrets) obstacle->UpdateHostile(player, this);
+    for (Obstacle* obstacle : obstacleRegistry.Of(ObstacleType::NEUTRAL)) obstacle->UpdateNeutral(this);
+}
 
-        if (orb->alpha <= 0) { delete orb; it = orbs.erase(it); continue; } // Remove faded
+void Game::SpawnOrb(float x, float y, int size, int xp) {
+    AllocScope allocScope(AllocTag::SPAWN);
+    world.Get<OrbArchetype>().Create({x, y}, {orbTexture, size, size, 255.0f}, {ORB_FADE_RATE},
+                                     {xp, collisionMasks.Acquire(MaskSprite::ORB, size, size)});
+}
 
-        // Magnet Logic
-        float dx = (player->x + player->width / 2.0f) - orb->x;
-        float dy = (player->y + player->height / 2.0f) - orb->y;
+// Damage and speed come from the bullet type, as for pattern volleys
+void Game::SpawnPlayerBullet(float x, float y, float dirX, float dirY, SDL_Texture* texture, int baseDamage, BulletType type) {
+    int size = Bullet::SizeOf(type);
+    float speed = Bullet::SpeedOf(type);
+    world.Get<PlayerBulletArchetype>().Create({x, y}, {x, y}, {dirX * speed, dirY * speed}, {texture, size, size, 255.0f},
+                                              {static_cast<int>(baseDamage * Bullet::DamageMultiplierOf(type))}, {});
+}
+
+void Game::SpawnEnemyBullet(float x, float y, float dirX, float dirY, SDL_Texture* texture, int baseDamage, BulletType type) {
+    int size = Bullet::SizeOf(type);
+    float speed = Bullet::SpeedOf(type);
+    world.Get<EnemyBulletArchetype>().Create({x, y}, {x, y}, {dirX * speed, dirY * speed}, {texture, size, size, 255.0f},
+                                             {static_cast<int>(baseDamage * Bullet::DamageMultiplierOf(type))}, {});
+}
+
+// Fading and magnet pull only read the player, so this runs alongside the obstacle/enemy updates
+void Game::UpdateOrbMotion() {
+    if (currentState != GameState::PLAYING) return;
+
+    // Fade system, then drop whatever faded out
+    world.Each<Appearance, Fade>([](Appearance& look, const Fade& fade) {
+        look.alpha = std::max(look.alpha - fade.rate, 0.0f);
+    });
+    world.Get<OrbArchetype>().DestroyIf<Appearance>([](const Appearance& look) { return look.alpha <= 0; });
+
+    // Magnet system: pickups near the player drift toward it
+    const float MAGNET_RADIUS_SQ = ORB_MAGNET_RADIUS * ORB_MAGNET_RADIUS;
+    float playerCenterX = player->x + player->width / 2.0f;
+    float playerCenterY = player->y + player->height / 2.0f;
+    world.Each<Position, Pickup>([&](Position& position, const Pickup&) {
+        float dx = playerCenterX - position.x;
+        float dy = playerCenterY - position.y;
         float distSq = dx * dx + dy * dy;
         if (distSq < MAGNET_RADIUS_SQ && distSq > 1.0f) {
             float dist = std::sqrt(distSq);
-            orb->x += (dx / dist) * ORB_MAGNET_SPEED; // Use constant
-            orb->y += (dy / dist) * ORB_MAGNET_SPEED; // Use constant
+            position.x += (dx / dist) * ORB_MAGNET_SPEED;
+            position.y += (dy / dist) * ORB_MAGNET_SPEED;
         }
+    });
+}
 
-        // Collection Check
-        SDL_Rect orbRect = orb->GetRect();
-        if (SDL_HasIntersection(&playerRect, &orbRect)) {
-            player->AddExperience(orb->xpValue); // <<< Use orb's value >>>
-            delete orb;
-            it = orbs.erase(it);
-        } else {
-            ++it;
-        }
-    }
+void Game::CollectOrbs() {
+    if (currentState != GameState::PLAYING) return;
 
-    SpawnEnemy(1);
+    Circle playerShape = player->GetShape();
 
-    if (stageManager.ShouldAdvanceStage()) {
-        player->LevelUp();
-        stageManager.AdvanceStage(player);
-         if (stageManager.IsGameWon()) {
-             currentState  = GameState::CREDITS;
-             creditsScrollY = SCREEN_HEIGHT;
-             creditsStartTime = SDL_GetTicks();
-         }
-    }
+    // Collection Check: shapes, then opaque pixels of both sprites
+    world.Get<OrbArchetype>().DestroyIf<Position, Appearance, Pickup>([&](const Position& position, const Appearance& look, const Pickup& pickup) {
+        Circle orbShape = {position.x, position.y, look.width / 2.0f};
+        bool collected = Overlaps(playerShape, orbShape);
+        if (collected && pickup.mask && player->mask) {
+            collected = MaskTouches(*pickup.mask, position.x, position.y, *player->mask, playerShape.x, playerShape.y, player->dirX, player->dirY);
+        }
+        if (collected) player->AddExperience(pickup.xp);
+        return collected;
+    });
 }
 
 void Game::UpdateCreditsState() {
+    Uint32 timeElapsed = SDL_GetTicks() - creditsStartTime;
+    float currentScrollPos = SCREEN_HEIGHT - (timeElapsed / 1000.0f * CREDITS_SCROLL_SPEED);
+
+    // Back to the menu once the last line has scrolled off the top
+    int endY = static_cast<int>(currentScrollPos) + CREDITS_LINE_COUNT * CREDITS_LINE_HEIGHT;
+    if (endY < -CREDITS_LINE_HEIGHT) {
+        ReturnToMenu();
+    }
 }
 
-void Game::Render() {
+void Game::Render(const RenderSnapshot& snapshot) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    renderArena.Reset();
     SDL_SetRenderDrawColor(renderer, 10, 10, 20, 255);
     SDL_RenderClear(renderer);
 
-    switch (currentState) {
+    switch (snapshot.state) {
         case GameState::MAIN_MENU:
-            RenderMainMenu();
+            RenderMainMenu(snapshot);
             break;
         case GameState::PLAYING:
-            RenderPlayingState();
+            RenderPlayingState(snapshot);
             break;
         case GameState::PAUSED:
-            RenderPausedScreen();
+            RenderPausedScreen(snapshot);
             break;
         case GameState::GAME_OVER:
-            RenderGameOver();
+            RenderGameOver(snapshot);
             break;
         case GameState::CREDITS:
-            RenderEndCredits();
+            RenderEndCredits(snapshot);
             break;
     }
 
+    // Draw time before present, which waits for vsync
+    renderMs = static_cast<float>(SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
     SDL_RenderPresent(renderer);
 }
 
-void Game::RenderMainMenu() {
+void Game::RenderMainMenu(const RenderSnapshot& snapshot) {
     if (menuBackgroundTexture) {
         SDL_RenderCopy(renderer, menuBackgroundTexture, NULL, NULL);
     }
@@ -921,49 +1356,55 @@ void Game::RenderMainMenu() {
     RenderText("SPACE SHOOTER", 0, SCREEN_HEIGHT / 5, true, {100, 180, 255, 255});
 
     // Menu Options
-    SDL_Color colorStart = (selectedMenuOption == 0) ? highlightColor : textColor;
-    SDL_Color colorQuit = (selectedMenuOption == 1) ? highlightColor : textColor;
+    SDL_Color colorStart = (snapshot.selectedMenuOption == 0) ? highlightColor : textColor;
+    SDL_Color colorHorde = (snapshot.selectedMenuOption == 1) ? highlightColor : textColor;
+    SDL_Color colorQuit = (snapshot.selectedMenuOption == 2) ? highlightColor : textColor;
 
-    std::string startText = (selectedMenuOption == 0) ? "> Start Game <" : "  Start Game  ";
-    std::string quitText = (selectedMenuOption == 1) ? "> Quit Game <" : "  Quit Game  ";
+    const char* startText = (snapshot.selectedMenuOption == 0) ? "> Start Game <" : "  Start Game  ";
+    const char* hordeText = (snapshot.selectedMenuOption == 1) ? "> Horde Mode <" : "  Horde Mode  ";
+    const char* quitText = (snapshot.selectedMenuOption == 2) ? "> Quit Game <" : "  Quit Game  ";
 
     RenderText(startText, 0, SCREEN_HEIGHT / 2 + 0, true, colorStart);
-    RenderText(quitText, 0, SCREEN_HEIGHT / 2 + 60, true, colorQuit);
+    RenderText(hordeText, 0, SCREEN_HEIGHT / 2 + 60, true, colorHorde);
+    RenderText(quitText, 0, SCREEN_HEIGHT / 2 + 120, true, colorQuit);
 
     // Instructions
     RenderText("W/S or UP/DOWN | ENTER to Select | ESC to Quit", 0, SCREEN_HEIGHT - 60, true, {180, 180, 180, 255});
 }
 
-void Game::RenderPlayingState() {
+void Game::RenderPlayingState(const RenderSnapshot& snapshot) {
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);  // Clear window
 
         // Background
         for (int i = -1; i <= 1; i++) {
             for (int j = -1; j <= 1; j++) {
-                int bgX = (-static_cast<int>(player->x) % backgroundWidth) + (i * backgroundWidth);
-                int bgY = (-static_cast<int>(player->y) % backgroundHeight) + (j * backgroundHeight);
+                int bgX = (-static_cast<int>(snapshot.cameraX) % backgroundWidth) + (i * backgroundWidth);
+                int bgY = (-static_cast<int>(snapshot.cameraY) % backgroundHeight) + (j * backgroundHeight);
                 SDL_Rect bgRect = { bgX, bgY, backgroundWidth, backgroundHeight };
                 SDL_RenderCopy(renderer, backgroundTexture, nullptr, &bgRect);
             }
         }
 
-        if (player) {
-         for (auto obs : obstacles) { if(obs) obs->Render(renderer, player); }
-         for (auto orb : orbs) { if(orb) orb->Render(renderer, player); }
-         for (auto enemy : enemies) { if(enemy) enemy->Render(renderer, player); }
-         for (auto bullet : bullets) { if(bullet) bullet->Render(renderer, player->x, player->y); }
-         for (auto enemyBullet : enemyBullets) { if(enemyBullet) enemyBullet->Render(renderer, player->x, player->y); }
-         player->Render(renderer);
-     }
+        // Obstacles, orbs, enemies, bullets and the player, already in draw order
+        for (const Sprite& sprite : snapshot.sprites) {
+            if (!sprite.texture) continue;
+            if (sprite.alpha != 255) {
+                SDL_SetTextureAlphaMod(sprite.texture, sprite.alpha);
+                SDL_RenderCopyEx(renderer, sprite.texture, nullptr, &sprite.dest, sprite.angle, nullptr, SDL_FLIP_NONE);
+                SDL_SetTextureAlphaMod(sprite.texture, 255);
+            } else {
+                SDL_RenderCopyEx(renderer, sprite.texture, nullptr, &sprite.dest, sprite.angle, nullptr, SDL_FLIP_NONE);
+            }
+        }
 
      // Game UI
-     RenderPlayingUI();
+     RenderPlayingUI(snapshot);
 }
 
 
-void Game::RenderPlayingUI() {
-     if (!uiFont || !player) return;
+void Game::RenderPlayingUI(const RenderSnapshot& snapshot) {
+     if (!uiFont || !snapshot.hasPlayer) return;
 
      int barX = 10;
      int barW = 220;
@@ -972,7 +1413,7 @@ void Game::RenderPlayingUI() {
 
      // --- Health Bar ---
      int healthBarY = 10;
-     float healthPercent = (player->maxHealth > 0) ? static_cast<float>(player->health) / player->maxHealth : 0.0f;
+     float healthPercent = (snapshot.hud.maxHealth > 0) ? static_cast<float>(snapshot.hud.health) / snapshot.hud.maxHealth : 0.0f;
      healthPercent = std::clamp(healthPercent, 0.0f, 1.0f);
      SDL_Color healthColor = {static_cast<Uint8>(200 * (1.0f - healthPercent)), static_cast<Uint8>(200 * healthPercent), 50, 255};
 
@@ -988,14 +1429,12 @@ void Game::RenderPlayingUI() {
      SDL_SetRenderDrawColor(renderer, 180, 180, 180, 255);
      SDL_RenderDrawRect(renderer, &bgHealthBarRect);
      // Health Value
-     std::stringstream ssHealth;
-     ssHealth << player->health << " / " << player->maxHealth;
-     RenderText(ssHealth.str(), barX + barW + spacing, healthBarY, false, textColor);
+     RenderText(renderArena.Format("%d / %d", snapshot.hud.health, snapshot.hud.maxHealth), barX + barW + spacing, healthBarY, false, textColor);
 
 
      // --- Experience Bar ---
      int xpBarY = healthBarY + barH + spacing;
-     float xpPercent = (player->experienceToNextLevel > 0) ? static_cast<float>(player->experience) / player->experienceToNextLevel : 0.0f;
+     float xpPercent = (snapshot.hud.experienceToNextLevel > 0) ? static_cast<float>(snapshot.hud.experience) / snapshot.hud.experienceToNextLevel : 0.0f;
      xpPercent = std::clamp(xpPercent, 0.0f, 1.0f);
      // Background
      SDL_Rect bgXpBarRect = {barX, xpBarY, barW, barH};
@@ -1009,27 +1448,60 @@ void Game::RenderPlayingUI() {
      SDL_SetRenderDrawColor(renderer, 180, 180, 180, 255);
      SDL_RenderDrawRect(renderer, &bgXpBarRect);
      // Text (Level)
-     std::stringstream ssLevel;
-     ssLevel << "Lvl: " << player->level;
-     RenderText(ssLevel.str(), barX + barW + spacing, xpBarY, false, textColor);
+     RenderText(renderArena.Format("Lvl: %d", snapshot.hud.level), barX + barW + spacing, xpBarY, false, textColor);
 
 
      // --- Stage Info (Top Right) ---
-     if (stageManager.GetCurrentStageNumber() > 0) {
+     if (snapshot.hud.stageNumber > 0) {
          int stageInfoX = SCREEN_WIDTH - 180;
          int stageInfoY = 10;
-         std::stringstream ssStage, ssKills;
-         ssStage << "Stage: " << stageManager.GetCurrentStageNumber();
-         ssKills << "Kills: " << stageManager.GetCurrentKillCount() << " / " << stageManager.GetCurrentKillGoal();
+         const char* kills = (snapshot.hud.killGoal > 0)
+             ? renderArena.Format("Kills: %d / %d", snapshot.hud.killCount, snapshot.hud.killGoal)
+             : renderArena.Format("Kills: %d", snapshot.hud.killCount);
 
-         RenderText(ssStage.str(), stageInfoX, stageInfoY, false, textColor);
-         RenderText(ssKills.str(), stageInfoX, stageInfoY + 25, false, textColor);
+         RenderText(renderArena.Format("Stage: %d", snapshot.hud.stageNumber), stageInfoX, stageInfoY, false, textColor);
+         RenderText(kills, stageInfoX, stageInfoY + 25, false, textColor);
      }
+
+     if (snapshot.stats.visible) RenderStats(snapshot);
 }
 
-void Game::RenderPausedScreen() {
+// --- Stats Overlay (Bottom Left) ---
+void Game::RenderStats(const RenderSnapshot& snapshot) {
+     const StatsValues& stats = snapshot.stats;
+     int statsX = 10;
+     int statsY = SCREEN_HEIGHT - 180;
+     SDL_Color statsColor = {180, 255, 180, 255};
+
+     RenderText(renderArena.Format("Enemies: %d", stats.enemies), statsX, statsY, false, statsColor);
+     RenderText(renderArena.Format("Bullets: %d player / %d enemy / %d in %d volleys",
+                                   stats.playerBullets, stats.enemyBullets, stats.patternBullets, stats.volleys),
+                statsX, statsY + 25, false, statsColor);
+     RenderText(renderArena.Format("Obstacles: %d (%d turrets)  Orbs: %d  Sprites drawn: %d",
+                                   stats.obstacles, stats.turrets, stats.orbs, stats.sprites),
+                statsX, statsY + 50, false, statsColor);
+     RenderText(renderArena.Format("Sim: %.2f ms  Render: %.2f ms", stats.simulationMs, renderMs),
+                statsX, statsY + 75, false, statsColor);
+     RenderText(renderArena.Format("Frame arena: sim %d KB (peak %d), render %d KB (peak %d) of %d KB, heap fallbacks %d",
+                                   stats.arenaKB, stats.arenaPeakKB,
+                                   static_cast<int>(renderArena.GetLastFrameBytes() / 1024), static_cast<int>(renderArena.GetPeakBytes() / 1024),
+                                   FRAME_ARENA_BYTES / 1024, stats.arenaOverflows + renderArena.GetLastFrameOverflows()),
+                statsX, statsY + 100, false, statsColor);
+
+     const AllocFrameStats& heap = stats.heap;
+     const char* heapLine = stats.allocTracking
+         ? renderArena.Format("Heap: %d allocs, %d KB / frame (spawn %d, shoot %d, streaming %d, snapshot %d, text %d, other %d)",
+                              heap.totalAllocations, static_cast<int>(heap.totalBytes / 1024),
+                              heap.allocations[static_cast<int>(AllocTag::SPAWN)], heap.allocations[static_cast<int>(AllocTag::SHOOT)],
+                              heap.allocations[static_cast<int>(AllocTag::STREAMING)], heap.allocations[static_cast<int>(AllocTag::SNAPSHOT)],
+                              heap.allocations[static_cast<int>(AllocTag::RENDER_TEXT)], heap.allocations[static_cast<int>(AllocTag::OTHER)])
+         : "Heap: not tracked (build with TRACK_ALLOCATIONS)";
+     RenderText(heapLine, statsX, statsY + 125, false, statsColor);
+}
+
+void Game::RenderPausedScreen(const RenderSnapshot& snapshot) {
     // Paused game
-    RenderPlayingState();
+    RenderPlayingState(snapshot);
 
     // Dimming Overlay
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
@@ -1043,9 +1515,9 @@ void Game::RenderPausedScreen() {
     RenderText("Press ESC to Return to Menu", 0, SCREEN_HEIGHT / 2 + 40, true, textColor);
 }
 
-void Game::RenderGameOver() {
+void Game::RenderGameOver(const RenderSnapshot& snapshot) {
     // Dimming Render
-    RenderPlayingState();
+    RenderPlayingState(snapshot);
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
     SDL_RenderFillRect(renderer, NULL);
@@ -1055,63 +1527,40 @@ void Game::RenderGameOver() {
     RenderText("Press ESC to Quit", 0, SCREEN_HEIGHT / 2 + 40, true, textColor);
 }
 
-void Game::RenderEndCredits() {
+void Game::RenderEndCredits(const RenderSnapshot& snapshot) {
     if (!uiFont) return;
 
-    Uint32 timeElapsed = SDL_GetTicks() - creditsStartTime;
+    Uint32 timeElapsed = SDL_GetTicks() - snapshot.creditsStartTime;
     // Scrolling from bottom
     float currentScrollPos = SCREEN_HEIGHT - (timeElapsed / 1000.0f * CREDITS_SCROLL_SPEED);
 
-    std::vector<std::string> creditsText = {
-        "GAME COMPLETE!",
-        "",
-        "A 2D Shooter Game",
-        "",
-        "--- CREDITS ---",
-        "Created By: [Ngo Minh Triet]",
-        "",
-        "Special Thanks:",
-        "SDL Libraries",
-        "Music: Chad Crouch| Charcoal",
-        "You (The Player!)",
-        "",
-        "",
-        "Thanks for Playing!"
-    };
-
     int currentY = static_cast<int>(currentScrollPos);
-    for (const std::string& line : creditsText) {
+    for (int i = 0; i < CREDITS_LINE_COUNT; ++i) {
         // RenderText helper
-        RenderText(line, 0, currentY, true, textColor);
+        RenderText(CREDITS_TEXT[i], 0, currentY, true, textColor);
         currentY += CREDITS_LINE_HEIGHT;
     }
-
-    if (currentY < -CREDITS_LINE_HEIGHT) {
-        ReturnToMenu();
-    }
 }
 
 void Game::Clean() {
     // Cleanup
+    jobSystem.Shutdown();
+    chunkStreamer.Stop();
+    StopRenderThread();
+    AllocTracker::PrintSummary(std::cout);
+
     if (player) {
         delete player;
         player = nullptr;
     }
 
-    for (auto bullet : bullets) delete bullet;
-    bullets.clear();
-
-    for (auto enemyBullet : enemyBullets) delete enemyBullet;
-    enemyBullets.clear();
-
     for (auto enemy : enemies) delete enemy;
     enemies.clear();
 
     for (auto obs : obstacles) delete obs;
     obstacles.clear();
 
-    for (auto orb : orbs) delete orb;
-    orbs.clear();
+    world.Clear();
 
     // --- Free Sounds ---
     if (backgroundMusic) Mix_FreeMusic(backgroundMusic);
@@ -1120,40 +1569,9 @@ void Game::Clean() {
     if (enemyDeathSound) Mix_FreeChunk(enemyDeathSound);
     if (playerDeathSound) Mix_FreeChunk(playerDeathSound);
 
-    // Destroy textures
-    if (playerTex) SDL_DestroyTexture(playerTex);
-
-    if (bulletTexNormal) SDL_DestroyTexture(bulletTexNormal);
-    if (bulletTexPowered) SDL_DestroyTexture(bulletTexPowered);
-    if (bulletTexSuperPowered) SDL_DestroyTexture(bulletTexSuperPowered);
-
-    if (enemyTexNormal) SDL_DestroyTexture(enemyTexNormal);
-    if (enemyTexFast) SDL_DestroyTexture(enemyTexFast);
-    if (enemyTexTank) SDL_DestroyTexture(enemyTexTank);
-    if (enemyTexQuick) SDL_DestroyTexture(enemyTexQuick);
-    if (enemyTexBoss) SDL_DestroyTexture(enemyTexBoss);
-
-    if (neutralObstacleTexture) SDL_DestroyTexture(neutralObstacleTexture);
-    if (hostileObstacleTexture) SDL_DestroyTexture(hostileObstacleTexture);
-
-    if (backgroundTexture) SDL_DestroyTexture(backgroundTexture);
-    if (menuBackgroundTexture) SDL_DestroyTexture(menuBackgroundTexture);
-
-    if (orbTexture) SDL_DestroyTexture(orbTexture);
-
-    if (uiFont) {
-        TTF_CloseFont(uiFont);
-        uiFont = nullptr;
-    }
-
     Mix_CloseAudio();
     Mix_Quit();
 
-    if (renderer) {
-        SDL_DestroyRenderer(renderer);
-        renderer = nullptr;
-    }
-
     if (window) {
         SDL_DestroyWindow(window);
         window = nullptr;
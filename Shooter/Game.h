@@ -11,24 +11,30 @@
 #include "Player.h"
 #include "Bullet.h"
 #include "Enemy.h"
+#include "EnemyStore.h"
+#include "EntityRegistry.h"
+#include "SpatialGrid.h"
 #include "Obstacle.h"
-#include "Orb.h"
+#include "Ecs.h"
+#include "FrameArena.h"
+#include "AllocTracker.h"
 #include "StageManager.h"
+#include "JobSystem.h"
+#include "FrameGraph.h"
+#include "FlowField.h"
+#include "AiLodScheduler.h"
+#include "TimerWheel.h"
+#include "ChunkStreamer.h"
+#include "LineOfSight.h"
+#include "CollisionMask.h"
+#include "PatternEmitter.h"
+#include "WeaponTable.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
 
 class Player;
-class Bullet;
 class Enemy;
 class Obstacle;
-class Orb;
-
-// --- GAME STATES ---
-enum class GameState {
-    MAIN_MENU,
-    PLAYING,
-    PAUSED,
-    GAME_OVER,
-    CREDITS
-};
 
 class Game {
 public:
@@ -45,11 +51,14 @@ public:
     bool Init(const char* title, int xpos, int ypos, int width, int height, bool fullscreen);
     void HandleEvents();
     void Update();
-    void Render();
+    void Render(const RenderSnapshot& snapshot);
     void Clean();
     bool Running() const;
 
+    // Per-thread generators seeded from gameSeed, so phases on job threads draw
+    // their own streams instead of sharing (or replaying) the C runtime's rand()
     float RandomFloat(float min, float max);
+    int RandomInt(int count);       // [0, count)
     bool LoadSounds();
     SDL_Renderer* GetRenderer();
 
@@ -59,6 +68,9 @@ public:
     SDL_Renderer* renderer;
     bool isRunning;
     Uint32 lastEnemySpawnTime;
+    TimerHandle spawnTimer;
+    bool spawnDue;
+    Uint32 gameSeed;                // seeds every thread's RandomFloat/RandomInt; redrawn for each game
     int bulletRenderOffsetX;
     int bulletRenderOffsetY;
     int backgroundWidth;
@@ -69,14 +81,34 @@ public:
 
     // --- Game Objects ---
     Player* player;
-    std::vector<Bullet*> bullets;
     std::vector<Enemy*> enemies;
-    std::vector<Bullet*> enemyBullets;
+    EnemyStore enemyStore;          // hot enemy state, indexed by Enemy::slot
+    EntityRegistry<Enemy, EnemyType, ENEMY_TYPE_COUNT> enemyRegistry;   // 'enemies' by type, kept by Enemy's constructor/destructor
+    SpatialGrid enemyGrid;          // separation neighbours and the player bullet broadphase; each rebuilds it
+    PatternEmitter bulletPatterns;  // weapon table volleys, one record per volley instead of a bullet entity each
     std::vector<Obstacle*> obstacles;
-    std::vector<Orb*> orbs;
+    EntityRegistry<Obstacle, ObstacleType, OBSTACLE_TYPE_COUNT> obstacleRegistry;   // 'obstacles' by type
+    SpatialGrid obstacleGrid;       // bullet broadphase, ids are indices into 'obstacles'; see RebuildObstacleGrid
+    std::vector<int> gridHits;      // grid query results of the bullet phases; cleared, never shrunk
+    GameWorld world;                // orbs and bullets, kept as components; see Ecs.h
 
     // --- Managers ---
     StageManager stageManager;
+    JobSystem jobSystem;
+    FlowField flowField;
+    AiLodScheduler lodScheduler;
+    TimerWheel timerWheel;          // cooldowns, AI state changes and spawns; advanced once per frame
+    ChunkStreamer chunkStreamer;    // deterministic obstacle layout per world chunk
+    std::vector<ChunkLayout> chunkLoads;
+    std::vector<Sint64> chunkUnloads;
+    LineOfSight lineOfSight;        // obstacle occupancy around the player, rebuilt with the obstacle list
+    LosBatch enemyLos;
+    LosBatch turretLos;
+    WeaponTable weapons;            // player and enemy weapons, from assets/weapons.txt
+    CollisionMaskBank collisionMasks;   // per-sprite pixel masks for the bullet and orb tests
+    FrameGraph frameGraph;
+    FrameArena frameArena;          // simulation temporaries, reset at the start of each Update
+    FrameArena renderArena;         // render thread temporaries, reset at the start of each Render
 
     // --- Textures ---
     SDL_Texture* playerTex;
@@ -110,13 +142,31 @@ public:
     // --- Menu State ---
     int selectedMenuOption;
 
+    // --- Stats Overlay (F3) ---
+    bool showStats;
+    float simulationMs;             // simulation thread
+    float renderMs;                 // render thread only
+    AllocFrameStats allocStats;     // heap use of the last frame, all threads (see AllocTracker)
+
+    // --- Render Thread ---
+    TripleBuffer<RenderSnapshot> renderBuffer;
+    SDL_Thread* renderThread;
+    SDL_sem* renderReady;
+    std::atomic<bool> renderRunning;
+    bool renderInitOk;
+
     // Other Helpers
     void SpawnEnemy(int count);
+    void SpawnEnemyOfType(EnemyType enemyType);
     void SpawnObstacles(int count);
-    void RenderText(const std::string& text, int x, int y, bool centered = false, SDL_Color color = {255, 255, 255, 255});
+    void SpawnOrb(float x, float y, int size, int xp);
+    // (x, y) is the bullet's centre, (dirX, dirY) its direction scaled by any speed bonus
+    void SpawnPlayerBullet(float x, float y, float dirX, float dirY, SDL_Texture* texture, int baseDamage, BulletType type);
+    void SpawnEnemyBullet(float x, float y, float dirX, float dirY, SDL_Texture* texture, int baseDamage, BulletType type);
+    void RenderText(const char* text, int x, int y, bool centered = false, SDL_Color color = {255, 255, 255, 255});
 
     // Game Flow Helpers
-    void StartNewGame();
+    void StartNewGame(GameMode mode = GameMode::CAMPAIGN);
     void ResetGameData();
     void ReturnToMenu();
     void TogglePause();
@@ -129,14 +179,38 @@ public:
     void HandleCreditsInput(SDL_Event& event);
 
     void UpdatePlayingState();
+    void BuildFrameGraph();
+    void UpdateObstacleSpawning();
+    void StreamChunks();
+    void RebuildObstacleGrid();
+    void CompactObstacles();
+    void IntegrateBullets();
+    void UpdatePlayerBullets();
+    void UpdateEnemyBullets();
+    void UpdatePatternBullets();
+    bool PathTouchesSprite(float fromX, float fromY, float toX, float toY, int diameter, const CollisionMask* mask,
+                           float centerX, float centerY, float dirX, float dirY, float& hitTime);
+    void UpdatePlayerObstacleCollision();
+    void UpdateEnemies();
+    void UpdateObstacles();
+    void UpdateOrbMotion();
+    void CollectOrbs();
     void UpdateCreditsState();
 
-    void RenderMainMenu();
-    void RenderPlayingState();
-    void RenderPlayingUI();
-    void RenderPausedScreen();
-    void RenderGameOver();
-    void RenderEndCredits();
+    static int RenderThreadMain(void* data);
+    bool InitRenderer();
+    void RunRenderLoop();
+    void ReleaseRenderResources();
+    void StopRenderThread();
+    void PublishSnapshot();
+
+    void RenderMainMenu(const RenderSnapshot& snapshot);
+    void RenderPlayingState(const RenderSnapshot& snapshot);
+    void RenderPlayingUI(const RenderSnapshot& snapshot);
+    void RenderStats(const RenderSnapshot& snapshot);
+    void RenderPausedScreen(const RenderSnapshot& snapshot);
+    void RenderGameOver(const RenderSnapshot& snapshot);
+    void RenderEndCredits(const RenderSnapshot& snapshot);
 };
 
 #endif
@@ -15,6 +15,7 @@ const Uint32 BASE_SHOT_COOLDOWN = 1000;
 const Uint32 HOSTILE_OBSTACLE_SHOOT_COOLDOWN = 4000;
 const int MAX_OBSTACLES = 30;
 const int MAX_ENEMIES = 20;
+const int HORDE_MAX_ENEMIES = 4000;      // upper bound for any stage's enemy cap (assets/stages.txt)
 const int OBSTACLE_GRID_SIZE = 600;
 const float OBSTACLE_HOVER_SPEED = 2.0f;
 const float OBSTACLE_HOVER_AMPLITUDE = 15.0f;
@@ -22,6 +23,31 @@ const int SPAWN_RADIUS = 1920;
 const int DESPAWN_RADIUS = 2120;
 const int NUM_GRID_CELLS = 20;
 const float MIN_SEPARATION_DISTANCE = 150.0f;
+const int FLOW_FIELD_CELL_SIZE = 64;
+const int FLOW_FIELD_DIMENSION = 64;
+const int FLOW_FIELD_REBUILD_TICKS = 10;
+const float FLOW_FIELD_OBSTACLE_MARGIN = 40.0f;
+const float ENEMY_GRID_CELL_SIZE = 128.0f;
+const float ENEMY_SEPARATION_WEIGHT = 1.0f;
+const float ENEMY_SEPARATION_PADDING = 8.0f;
+const float OBSTACLE_GRID_CELL_SIZE = 256.0f;  // obstacles are 50-150 px and a few per chunk
+const float AI_LOD_SCREEN_MARGIN = 128.0f;
+const float AI_LOD_NEAR_RADIUS = 1600.0f;
+const unsigned int AI_LOD_NEAR_INTERVAL = 3;
+const int AI_LOD_FAR_BUDGET = 8;
+const Uint32 ENEMY_STATE_RECHECK_INTERVAL = 200;
+const int CHUNK_SIZE = 1024;
+const int CHUNK_LOAD_RADIUS = 2;         // 5x5 chunks around the player
+const int CHUNK_UNLOAD_RADIUS = 3;       // one chunk of hysteresis
+const int CHUNK_OBSTACLE_COUNT = 3;      // about the old MAX_OBSTACLES density
+const int CHUNK_SYNC_RADIUS = 1;          // built inline if the generator thread is late
+const float CHUNK_PREDICT_TICKS = 120.0f; // look two seconds ahead along the player velocity
+const int POISSON_TILE_CHUNKS = 4;        // blue-noise sites repeat every 4x4 chunks
+const int POISSON_CANDIDATES = 30;        // Bridson attempts per active point
+const int LOS_CELL_SIZE = 32;
+const int LOS_GRID_DIMENSION = 64;        // 2048 px square around the player, past the longest firing range
+const int LOS_QUERY_BUDGET = 64;          // rays per batch per tick
+const int FRAME_ARENA_BYTES = 256 * 1024; // per arena (simulation, render); overflow falls back to the heap
 const int ORB_SIZE = 30;
 const float ORB_FADE_RATE = 0.5f;
 const float ORB_MAGNET_RADIUS = 150.0f;
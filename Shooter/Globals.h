@@ -28,6 +28,7 @@ extern const Uint32 BASE_SHOT_COOLDOWN;
 extern const Uint32 HOSTILE_OBSTACLE_SHOOT_COOLDOWN;
 extern const int MAX_OBSTACLES;
 extern const int MAX_ENEMIES;
+extern const int HORDE_MAX_ENEMIES;
 extern const int OBSTACLE_GRID_SIZE;
 extern const float OBSTACLE_HOVER_AMPLITUDE;
 extern const float OBSTACLE_HOVER_SPEED;
@@ -35,6 +36,31 @@ extern const int SPAWN_RADIUS;
 extern const int DESPAWN_RADIUS;
 extern const int NUM_GRID_CELLS;
 extern const float MIN_SEPARATION_DISTANCE;
+extern const int FLOW_FIELD_CELL_SIZE;
+extern const int FLOW_FIELD_DIMENSION;
+extern const int FLOW_FIELD_REBUILD_TICKS;
+extern const float FLOW_FIELD_OBSTACLE_MARGIN;
+extern const float ENEMY_GRID_CELL_SIZE;
+extern const float ENEMY_SEPARATION_WEIGHT;
+extern const float ENEMY_SEPARATION_PADDING;
+extern const float OBSTACLE_GRID_CELL_SIZE;
+extern const float AI_LOD_SCREEN_MARGIN;
+extern const float AI_LOD_NEAR_RADIUS;
+extern const unsigned int AI_LOD_NEAR_INTERVAL;
+extern const int AI_LOD_FAR_BUDGET;
+extern const Uint32 ENEMY_STATE_RECHECK_INTERVAL;
+extern const int CHUNK_SIZE;
+extern const int CHUNK_LOAD_RADIUS;
+extern const int CHUNK_UNLOAD_RADIUS;
+extern const int CHUNK_OBSTACLE_COUNT;
+extern const int CHUNK_SYNC_RADIUS;
+extern const float CHUNK_PREDICT_TICKS;
+extern const int POISSON_TILE_CHUNKS;
+extern const int POISSON_CANDIDATES;
+extern const int LOS_CELL_SIZE;
+extern const int LOS_GRID_DIMENSION;
+extern const int LOS_QUERY_BUDGET;
+extern const int FRAME_ARENA_BYTES;
 extern const int ORB_SIZE;
 extern const float ORB_FADE_RATE;
 extern const float ORB_MAGNET_RADIUS;
@@ -49,11 +75,13 @@ enum class EnemyType {
     QUICK,
     BOSS
 };
+const int ENEMY_TYPE_COUNT = static_cast<int>(EnemyType::BOSS) + 1;
 
 enum class ObstacleType {
     NEUTRAL,
     HOSTILE
 };
+const int OBSTACLE_TYPE_COUNT = static_cast<int>(ObstacleType::HOSTILE) + 1;
 
 enum class BulletType {
     NORMAL,
@@ -69,11 +97,18 @@ enum class EnemyState {
     CIRCLING
 };
 
-enum class ShootingPattern {
-    SINGLE,
-    DOUBLE,
-    TRIPLE,
-    SIDEWAYS
+// --- GAME STATES ---
+enum class GameState {
+    MAIN_MENU,
+    PLAYING,
+    PAUSED,
+    GAME_OVER,
+    CREDITS
+};
+
+enum class GameMode {
+    CAMPAIGN,
+    HORDE
 };
 
 #endif
@@ -0,0 +1,169 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <iostream>
+
+// Index of the queue owned by the calling thread (0 = main thread)
+static thread_local int currentQueueIndex = 0;
+
+JobSystem::JobSystem() : wakeSignal(nullptr), running(false) {}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+bool JobSystem::Init(int workerCount) {
+    if (running) return true;
+    if (workerCount < 0) workerCount = 0;
+
+    wakeSignal = SDL_CreateSemaphore(0);
+    if (!wakeSignal) {
+        std::cerr << "JobSystem: SDL_CreateSemaphore Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    // Queue 0 is the main thread, 1..workerCount are the workers
+    for (int i = 0; i <= workerCount; ++i) {
+        WorkQueue* queue = new WorkQueue();
+        queue->lock = SDL_CreateMutex();
+        queues.push_back(queue);
+    }
+
+    running = true;
+    workerStarts.reserve(workerCount);
+    for (int i = 1; i <= workerCount; ++i) {
+        workerStarts.push_back({this, i});
+        SDL_Thread* thread = SDL_CreateThread(WorkerMain, "JobWorker", &workerStarts.back());
+        if (!thread) {
+            std::cerr << "JobSystem: SDL_CreateThread Error: " << SDL_GetError() << std::endl;
+            break;
+        }
+        threads.push_back(thread);
+    }
+
+    std::cout << "JobSystem started with " << threads.size() << " worker thread(s)." << std::endl;
+    return true;
+}
+
+void JobSystem::Shutdown() {
+    if (!running) return;
+
+    running = false;
+    for (size_t i = 0; i < threads.size(); ++i) {
+        SDL_SemPost(wakeSignal);
+    }
+    for (auto thread : threads) {
+        SDL_WaitThread(thread, nullptr);
+    }
+    threads.clear();
+    workerStarts.clear();
+
+    for (auto queue : queues) {
+        SDL_DestroyMutex(queue->lock);
+        delete queue;
+    }
+    queues.clear();
+
+    SDL_DestroySemaphore(wakeSignal);
+    wakeSignal = nullptr;
+}
+
+void JobSystem::Submit(Job job, JobCounter* counter) {
+    if (queues.empty()) {
+        // Not initialised: behave like a plain function call
+        job();
+        return;
+    }
+
+    if (counter) counter->fetch_add(1, std::memory_order_relaxed);
+
+    WorkQueue* queue = queues[currentQueueIndex];
+    SDL_LockMutex(queue->lock);
+    queue->jobs.push_back({std::move(job), counter});
+    SDL_UnlockMutex(queue->lock);
+
+    if (!threads.empty()) SDL_SemPost(wakeSignal);
+}
+
+void JobSystem::Wait(JobCounter* counter) {
+    if (!counter) return;
+    while (counter->load(std::memory_order_acquire) > 0) {
+        // Help with the backlog instead of sleeping
+        if (!RunOne(currentQueueIndex)) {
+            SDL_Delay(0);
+        }
+    }
+}
+
+void JobSystem::ParallelFor(int count, int chunkSize, const std::function<void(int, int)>& body) {
+    if (count <= 0) return;
+    if (chunkSize <= 0) chunkSize = 1;
+
+    if (count <= chunkSize || threads.empty()) {
+        body(0, count);
+        return;
+    }
+
+    JobCounter pending(0);
+    for (int begin = 0; begin < count; begin += chunkSize) {
+        int end = std::min(begin + chunkSize, count);
+        Submit([&body, begin, end]() { body(begin, end); }, &pending);
+    }
+    Wait(&pending);
+}
+
+int JobSystem::GetWorkerCount() const {
+    return static_cast<int>(threads.size());
+}
+
+int JobSystem::WorkerMain(void* data) {
+    WorkerStart* start = static_cast<WorkerStart*>(data);
+    JobSystem* system = start->system;
+    currentQueueIndex = start->queueIndex;
+
+    while (system->running) {
+        SDL_SemWait(system->wakeSignal);
+        while (system->RunOne(currentQueueIndex)) {}
+    }
+    return 0;
+}
+
+bool JobSystem::RunOne(int queueIndex) {
+    PendingJob pending;
+    if (!PopLocal(queueIndex, pending) && !Steal(queueIndex, pending)) {
+        return false;
+    }
+
+    pending.job();
+    if (pending.counter) pending.counter->fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool JobSystem::PopLocal(int queueIndex, PendingJob& out) {
+    WorkQueue* queue = queues[queueIndex];
+    bool found = false;
+    SDL_LockMutex(queue->lock);
+    if (!queue->jobs.empty()) {
+        out = std::move(queue->jobs.back());
+        queue->jobs.pop_back();
+        found = true;
+    }
+    SDL_UnlockMutex(queue->lock);
+    return found;
+}
+
+bool JobSystem::Steal(int thiefIndex, PendingJob& out) {
+    int queueCount = static_cast<int>(queues.size());
+    for (int i = 1; i < queueCount; ++i) {
+        WorkQueue* victim = queues[(thiefIndex + i) % queueCount];
+        bool found = false;
+        SDL_LockMutex(victim->lock);
+        if (!victim->jobs.empty()) {
+            out = std::move(victim->jobs.front());
+            victim->jobs.pop_front();
+            found = true;
+        }
+        SDL_UnlockMutex(victim->lock);
+        if (found) return true;
+    }
+    return false;
+}
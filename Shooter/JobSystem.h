@@ -0,0 +1,61 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <SDL.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <vector>
+
+typedef std::function<void()> Job;
+typedef std::atomic<int> JobCounter;
+
+// Small work-stealing thread pool. Every thread owns a queue; the owner pops
+// from the back (newest first) and idle threads steal from the front of the
+// others. Queue 0 belongs to the main thread, which helps out while it waits.
+class JobSystem {
+public:
+    JobSystem();
+    ~JobSystem();
+
+    bool Init(int workerCount);
+    void Shutdown();
+
+    // counter (optional) is incremented now and decremented when the job finishes
+    void Submit(Job job, JobCounter* counter = nullptr);
+    void Wait(JobCounter* counter);
+
+    // Splits [0, count) into chunks of chunkSize and runs body(begin, end) on each
+    void ParallelFor(int count, int chunkSize, const std::function<void(int, int)>& body);
+
+    int GetWorkerCount() const;
+
+private:
+    struct PendingJob {
+        Job job;
+        JobCounter* counter;
+    };
+
+    struct WorkQueue {
+        std::deque<PendingJob> jobs;
+        SDL_mutex* lock;
+    };
+
+    struct WorkerStart {
+        JobSystem* system;
+        int queueIndex;
+    };
+
+    std::vector<WorkQueue*> queues;
+    std::vector<SDL_Thread*> threads;
+    std::vector<WorkerStart> workerStarts;
+    SDL_sem* wakeSignal;
+    std::atomic<bool> running;
+
+    static int WorkerMain(void* data);
+    bool RunOne(int queueIndex);
+    bool PopLocal(int queueIndex, PendingJob& out);
+    bool Steal(int thiefIndex, PendingJob& out);
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "LineOfSight.h"
+#include "Globals.h"
+#include "Obstacle.h"
+#include <limits>
+
+LineOfSight::LineOfSight() : originX(0), originY(0) {
+    blocked.assign(LOS_GRID_DIMENSION * LOS_GRID_DIMENSION, 0);
+}
+
+void LineOfSight::Rebuild(float centerX, float centerY, const std::vector<Obstacle*>& obstacles) {
+    // Snap the origin to whole cells so cell boundaries stay put in the world
+    int halfExtent = LOS_GRID_DIMENSION / 2 * LOS_CELL_SIZE;
+    originX = static_cast<int>(std::floor(centerX / LOS_CELL_SIZE)) * LOS_CELL_SIZE - halfExtent;
+    originY = static_cast<int>(std::floor(centerY / LOS_CELL_SIZE)) * LOS_CELL_SIZE - halfExtent;
+    std::fill(blocked.begin(), blocked.end(), 0);
+
+    const float half = LOS_CELL_SIZE * 0.5f;
+    for (const auto& obs : obstacles) {
+        // Cells whose centre is inside the obstacle: first centre at or after the left edge, last before the right
+        int minX = static_cast<int>(std::ceil((obs->x - originX - half) / LOS_CELL_SIZE));
+        int minY = static_cast<int>(std::ceil((obs->y - originY - half) / LOS_CELL_SIZE));
+        int maxX = static_cast<int>(std::ceil((obs->x + obs->width - originX - half) / LOS_CELL_SIZE)) - 1;
+        int maxY = static_cast<int>(std::ceil((obs->y + obs->height - originY - half) / LOS_CELL_SIZE)) - 1;
+        minX = std::max(minX, 0);
+        minY = std::max(minY, 0);
+        maxX = std::min(maxX, LOS_GRID_DIMENSION - 1);
+        maxY = std::min(maxY, LOS_GRID_DIMENSION - 1);
+        for (int cellY = minY; cellY <= maxY; ++cellY) {
+            for (int cellX = minX; cellX <= maxX; ++cellX) {
+                blocked[cellY * LOS_GRID_DIMENSION + cellX] = 1;
+            }
+        }
+    }
+}
+
+bool LineOfSight::IsBlocked(int cellX, int cellY) const {
+    if (cellX < 0 || cellY < 0 || cellX >= LOS_GRID_DIMENSION || cellY >= LOS_GRID_DIMENSION) return false;
+    return blocked[cellY * LOS_GRID_DIMENSION + cellX] != 0;
+}
+
+bool LineOfSight::IsClear(float fromX, float fromY, float toX, float toY, float startMargin, float endMargin) const {
+    float dx = toX - fromX;
+    float dy = toY - fromY;
+    float length = std::sqrt(dx * dx + dy * dy);
+    const float pad = LOS_CELL_SIZE * 0.7072f;
+    const float firstUseful = startMargin + pad;
+    const float lastUseful = length - endMargin - pad;
+    if (lastUseful <= firstUseful) return true;
+
+    // Positions in cells, distances along the ray in pixels
+    float startX = (fromX - originX) / LOS_CELL_SIZE;
+    float startY = (fromY - originY) / LOS_CELL_SIZE;
+    float dirX = dx / length;
+    float dirY = dy / length;
+    int cellX = static_cast<int>(std::floor(startX));
+    int cellY = static_cast<int>(std::floor(startY));
+    int endCellX = static_cast<int>(std::floor((toX - originX) / LOS_CELL_SIZE));
+    int endCellY = static_cast<int>(std::floor((toY - originY) / LOS_CELL_SIZE));
+
+    const float INF = std::numeric_limits<float>::infinity();
+    int stepX = (dirX > 0.0f) ? 1 : -1;
+    int stepY = (dirY > 0.0f) ? 1 : -1;
+    // Distance along the ray to cross one cell, and to the first boundary on each axis
+    float deltaX = (dirX != 0.0f) ? LOS_CELL_SIZE / std::fabs(dirX) : INF;
+    float deltaY = (dirY != 0.0f) ? LOS_CELL_SIZE / std::fabs(dirY) : INF;
+    float nextX = (dirX != 0.0f) ? ((stepX > 0 ? (cellX + 1 - startX) : (startX - cellX)) * deltaX) : INF;
+    float nextY = (dirY != 0.0f) ? ((stepY > 0 ? (cellY + 1 - startY) : (startY - cellY)) * deltaY) : INF;
+
+    float enter = 0.0f;
+    int steps = std::abs(endCellX - cellX) + std::abs(endCellY - cellY) + 1;
+    for (int i = 0; i < steps && enter < lastUseful; ++i) {
+        if (enter >= firstUseful && IsBlocked(cellX, cellY)) return false;
+
+        enter = std::min(nextX, nextY);
+        if (nextX < nextY) {
+            nextX += deltaX;
+            cellX += stepX;
+        } else {
+            nextY += deltaY;
+            cellY += stepY;
+        }
+    }
+    return true;
+}
+
+LosBatch::LosBatch() : cursor(0) {}
+
+void LosBatch::Clear() {
+    queries.clear();
+}
+
+void LosBatch::Add(float fromX, float fromY, float toX, float toY, float startMargin, float endMargin, bool* result) {
+    queries.push_back({fromX, fromY, toX, toY, startMargin, endMargin, result});
+}
+
+void LosBatch::Resolve(const LineOfSight& lineOfSight, int budget) {
+    int count = static_cast<int>(queries.size());
+    if (count == 0) return;
+
+    int done = std::min(budget, count);
+    int start = cursor % count;
+    for (int i = 0; i < done; ++i) {
+        const Query& query = queries[(start + i) % count];
+        *query.result = lineOfSight.IsClear(query.fromX, query.fromY, query.toX, query.toY, query.startMargin, query.endMargin);
+    }
+    cursor = (start + done) % count;
+}
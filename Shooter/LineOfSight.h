@@ -0,0 +1,54 @@
+#ifndef LINEOFSIGHT_H
+#define LINEOFSIGHT_H
+
+#include <vector>
+
+class Obstacle;
+
+// Coarse occupancy grid of the obstacles around the player, for "can this
+// shooter see the target" tests. A cell counts as blocked when its centre
+// lies inside an obstacle. Rays are walked cell by cell with the
+// Amanatides-Woo DDA, so a test costs one step per crossed cell and never
+// looks at the obstacle list. Outside the grid everything is clear.
+class LineOfSight {
+public:
+    LineOfSight();
+
+    void Rebuild(float centerX, float centerY, const std::vector<Obstacle*>& obstacles);
+
+    // Blocked cells entered within startMargin of the start (the shooter's
+    // own body) or endMargin of the end (the target's) are ignored; both are
+    // padded by half a cell diagonal, the most a blocked cell sticks out.
+    bool IsClear(float fromX, float fromY, float toX, float toY, float startMargin, float endMargin) const;
+
+private:
+    bool IsBlocked(int cellX, int cellY) const;
+
+    int originX, originY;          // world position of the grid's top-left corner
+    std::vector<unsigned char> blocked;
+};
+
+// Line-of-sight tests gathered over a tick and answered together, at most
+// 'budget' rays per Resolve. Unanswered queries keep their previous result and
+// the next Resolve starts where this one stopped, so every shooter is
+// refreshed within a few ticks even when there are many of them.
+class LosBatch {
+public:
+    LosBatch();
+
+    void Clear();
+    void Add(float fromX, float fromY, float toX, float toY, float startMargin, float endMargin, bool* result);
+    void Resolve(const LineOfSight& lineOfSight, int budget);
+
+private:
+    struct Query {
+        float fromX, fromY, toX, toY;
+        float startMargin, endMargin;
+        bool* result;
+    };
+
+    std::vector<Query> queries;
+    int cursor;
+};
+
+#endif
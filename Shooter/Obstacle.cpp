@@ -3,50 +3,50 @@
 #include "Bullet.h"
 #include "Game.h"
 #include "Globals.h"
+#include "RenderSnapshot.h"
+#include "FastMath.h"
+#include "AllocTracker.h"
+
+// --- Precomputed neutral spin ---
+static const Rotor SPIN_CLOCKWISE = MakeRotor(OBSTACLE_ROTATION_SPEED);
+static const Rotor SPIN_COUNTER_CLOCKWISE = MakeRotor(-OBSTACLE_ROTATION_SPEED);
 #include <cmath>
 #include <SDL.h>
 
 Obstacle::Obstacle(float x, float y, float w, float h, SDL_Texture* tex, ObstacleType type_in, int health_in, SDL_Texture* bulletTex)
-    : x(x), y(y), width(w), height(h), texture(tex), bulletTexture((type == ObstacleType::HOSTILE) ? bulletTex : nullptr), type(type_in), health(health_in), initialY(y), angle(0.0f), lastShotTime(0) {}
+    : x(x), y(y), width(w), height(h), texture(tex), bulletTexture((type == ObstacleType::HOSTILE) ? bulletTex : nullptr), type(type_in), health(health_in), initialY(y), dirX(0.0f), dirY(-1.0f), lastShotTime(0), shotTimerWheel(nullptr), shotReady(true), clearShot(false),
+      chunkKey(0), chunkIndex(-1), mask(nullptr), typeSlot(-1), registry(nullptr) {}
+
+Obstacle::~Obstacle() {
+    if (shotTimerWheel) shotTimerWheel->Cancel(shotTimer);
+    if (registry) registry->Remove(this);
+}
 
 SDL_Rect Obstacle::GetRect() const {
     return { (int)x, (int)y, (int)width, (int)height };
 }
 
-void Obstacle::Render(SDL_Renderer* renderer, Player* player) {
-    SDL_Rect rect = {static_cast<int>(x - player->x + SCREEN_WIDTH / 2), static_cast<int>(y - player->y + SCREEN_HEIGHT / 2), (int)width, (int)height};
-    SDL_Point center = { (int)width / 2, (int)height / 2 };
-    SDL_RenderCopyEx(renderer, texture, NULL, &rect, angle, &center, SDL_FLIP_NONE);
+Obb Obstacle::GetShape() const {
+    return MakeObb(x + width / 2.0f, y + height / 2.0f, static_cast<float>(width), static_cast<float>(height), dirX, dirY);
 }
 
-void Obstacle::Update(Player* player, std::vector<Bullet*>& enemyBullets, Game* game) {
-    switch (type) {
-        case ObstacleType::HOSTILE:
-            UpdateHostile(player, enemyBullets, game);
-            break;
-        case ObstacleType::NEUTRAL:
-            UpdateNeutral(game);
-            break;
-    }
+void Obstacle::Render(RenderSnapshot& snapshot, Player* player) {
+    SDL_Rect rect = {static_cast<int>(x - player->x + SCREEN_WIDTH / 2), static_cast<int>(y - player->y + SCREEN_HEIGHT / 2), (int)width, (int)height};
+    snapshot.AddSprite({texture, rect, DirectionToSpriteAngle(dirX, dirY), 255});
 }
 
 // --- Helper for Neutral Obstacle behavior ---
 void Obstacle::UpdateNeutral(Game* game) {
     Uint32 currentTime = SDL_GetTicks();
     // Hovering motion using sine wave
-    y = initialY + sin(currentTime * OBSTACLE_HOVER_SPEED / 1000.0f) * OBSTACLE_HOVER_AMPLITUDE;
+    y = initialY + FastSin(currentTime * OBSTACLE_HOVER_SPEED / 1000.0f) * OBSTACLE_HOVER_AMPLITUDE;
 
     // Gentle random rotation
-    float rotationChange = (rand() % 100 < 50 ? 1 : -1) * OBSTACLE_ROTATION_SPEED;
-    angle += rotationChange;
-
-    // Keep angle 0->360
-    if (angle >= 360.0f) angle -= 360.0f;
-    if (angle < 0.0f) angle += 360.0f;
+    RotateDirection(dirX, dirY, (game->RandomInt(2) == 0) ? SPIN_CLOCKWISE : SPIN_COUNTER_CLOCKWISE);
 }
 
 // --- Helper for Hostile Obstacle behavior ---
-void Obstacle::UpdateHostile(Player* player, std::vector<Bullet*>& enemyBullets, Game* game) {
+void Obstacle::UpdateHostile(Player* player, Game* game) {
     if (!player) return;
 
     float dx = player->x + player->width/2.0f - (x + width/2.0f);
@@ -55,42 +55,51 @@ void Obstacle::UpdateHostile(Player* player, std::vector<Bullet*>& enemyBullets,
     const float shootRangeSq = 700.0f * 700.0f;
 
     if (distanceSq < shootRangeSq) {
-        angle = atan2(dy, dx) * 180.0f / M_PI + 90.0f;
-        Shoot(enemyBullets, player);
+        // Face the player
+        float faceX = dx, faceY = dy;
+        if (NormalizeDirection(faceX, faceY)) {
+            dirX = faceX;
+            dirY = faceY;
+        }
+        if (shotReady && clearShot) Shoot(player, game);
     }
 }
 
-void Obstacle::Shoot(std::vector<Bullet*>& enemyBullets, Player* player) {
+void Obstacle::Shoot(Player* player, Game* game) {
+    AllocScope allocScope(AllocTag::SHOOT);
     Uint32 currentTime = SDL_GetTicks();
 
-    if (currentTime - lastShotTime > HOSTILE_OBSTACLE_SHOOT_COOLDOWN) {
-        float dx = player->x - x;
-        float dy = player->y - y;
-        float distance = sqrt(dx * dx + dy * dy);
+    float dx = player->x - x;
+    float dy = player->y - y;
+    float distance = sqrt(dx * dx + dy * dy);
 
-        // 2. Check Range
-        if (distance > 0) {
-            float normDX = dx / distance;
-            float normDY = dy / distance;
+    // 2. Check Range
+    if (distance > 0) {
+        float normDX = dx / distance;
+        float normDY = dy / distance;
 
-            float bulletVX = normDX * BULLET_SPEED;
-            float bulletVY = normDY * BULLET_SPEED;
+        float bulletVX = normDX * BULLET_SPEED;
+        float bulletVY = normDY * BULLET_SPEED;
 
-            BulletType bulletType = BulletType::NORMAL;
-            int baseDamage = 20;
+        BulletType bulletType = BulletType::NORMAL;
+        int baseDamage = 20;
 
-            float obstacleCenterX = x + width / 2.0f;
-            float obstacleCenterY = y + height / 2.0f;
+        float obstacleCenterX = x + width / 2.0f;
+        float obstacleCenterY = y + height / 2.0f;
 
-            float spawnOffsetDistance = (std::max(width, height) / 2.0f) + 1.0f;
+        float spawnOffsetDistance = (std::max(width, height) / 2.0f) + 1.0f;
 
-            float spawnX = obstacleCenterX + normDX * spawnOffsetDistance;
-            float spawnY = obstacleCenterY + normDY * spawnOffsetDistance;
+        float spawnX = obstacleCenterX + normDX * spawnOffsetDistance;
+        float spawnY = obstacleCenterY + normDY * spawnOffsetDistance;
 
-            enemyBullets.push_back(new Bullet(spawnX, spawnY, bulletVX, bulletVY, bulletTexture, baseDamage, bulletType));
+        game->SpawnEnemyBullet(spawnX, spawnY, bulletVX, bulletVY, bulletTexture, baseDamage, bulletType);
 
-            lastShotTime = currentTime;
-        }
+        lastShotTime = currentTime;
+
+        // Cooldown: the wheel re-arms the shot instead of polling the clock
+        shotReady = false;
+        shotTimerWheel = &game->timerWheel;
+        shotTimer = shotTimerWheel->Schedule(currentTime + HOSTILE_OBSTACLE_SHOOT_COOLDOWN + 1, [this]() { shotReady = true; });
     }
 }
 
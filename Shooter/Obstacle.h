@@ -3,11 +3,16 @@
 
 #include <SDL.h>
 #include "Globals.h"
+#include "CollisionShapes.h"
+#include "CollisionMask.h"
+#include "EntityRegistry.h"
 #include "Game.h"
+#include "Orientation.h"
+#include "TimerWheel.h"
 
 class Player;
-class Bullet;
 class Game;
+struct RenderSnapshot;
 
 class Obstacle {
 public:
@@ -19,17 +24,27 @@ public:
     SDL_Texture* texture;
     SDL_Texture* bulletTexture;
     Uint32 lastShotTime;
+    TimerHandle shotTimer;
+    TimerWheel* shotTimerWheel;     // set once a cooldown has been scheduled
+    bool shotReady;
+    bool clearShot;     // last line-of-sight answer, see Game::UpdateObstacles
     float initialY;
-    float angle;
+    float dirX, dirY;   // unit heading, (0, -1) = unrotated sprite
+    Sint64 chunkKey;    // world chunk this obstacle was streamed in with
+    int chunkIndex;     // index in that chunk's layout, -1 if not streamed
+    const CollisionMask* mask;  // sprite pixels at this size, null if unavailable
+    int typeSlot;
+    EntityRegistry<Obstacle, ObstacleType, OBSTACLE_TYPE_COUNT>* registry;   // set once registered, see Game::StreamChunks
 
     Obstacle(float x, float y, float w, float h, SDL_Texture* tex, ObstacleType type, int health, SDL_Texture* bulletTex);
-    void Update(Player* player, std::vector<Bullet*>& enemyBullets, Game* game);
+    ~Obstacle();
     void UpdateNeutral(Game* game);
-    void UpdateHostile(Player* player, std::vector<Bullet*>& enemyBullets, Game* game);
-    void Shoot(std::vector<Bullet*>& enemyBullets, Player* player);
-    void Render(SDL_Renderer* renderer, Player* player);
+    void UpdateHostile(Player* player, Game* game);
+    void Shoot(Player* player, Game* game);
+    void Render(RenderSnapshot& snapshot, Player* player);
     void TakeDamage(int damage);
     SDL_Rect GetRect() const;
+    Obb GetShape() const;   // turns with the sprite
 };
 
 #endif
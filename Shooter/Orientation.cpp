@@ -0,0 +1,55 @@
+#include "Orientation.h"
+#include "FastMath.h"
+#include <cmath>
+
+Rotor MakeRotor(float degrees) {
+    Rotor rotor;
+    FastSinCos(degrees * FAST_DEG_TO_RAD, rotor.s, rotor.c);
+    return rotor;
+}
+
+void RotateDirection(float& dirX, float& dirY, const Rotor& rotor) {
+    float x = dirX * rotor.c - dirY * rotor.s;
+    float y = dirX * rotor.s + dirY * rotor.c;
+
+    // One Newton step toward length 1 keeps repeated small turns from drifting
+    float scale = 0.5f * (3.0f - (x * x + y * y));
+    dirX = x * scale;
+    dirY = y * scale;
+}
+
+void RotatedDirection(float dirX, float dirY, const Rotor& rotor, float& outX, float& outY) {
+    outX = dirX * rotor.c - dirY * rotor.s;
+    outY = dirX * rotor.s + dirY * rotor.c;
+}
+
+bool NormalizeDirection(float& x, float& y) {
+    float lengthSq = x * x + y * y;
+    if (lengthSq < 1e-8f) return false;
+    float invLength = 1.0f / std::sqrt(lengthSq);
+    x *= invLength;
+    y *= invLength;
+    return true;
+}
+
+void TurnToward(float& dirX, float& dirY, float targetX, float targetY, float fraction) {
+    // More than 90 degrees away: head for the perpendicular on the target's side
+    // first, otherwise blending with a (nearly) opposite vector would stall
+    float dot = dirX * targetX + dirY * targetY;
+    if (dot < 0.0f) {
+        float side = (dirX * targetY - dirY * targetX) >= 0.0f ? 1.0f : -1.0f;
+        targetX = -dirY * side;
+        targetY = dirX * side;
+    }
+
+    float x = dirX + (targetX - dirX) * fraction;
+    float y = dirY + (targetY - dirY) * fraction;
+    if (NormalizeDirection(x, y)) {
+        dirX = x;
+        dirY = y;
+    }
+}
+
+double DirectionToSpriteAngle(float dirX, float dirY) {
+    return FastAtan2(dirY, dirX) * FAST_RAD_TO_DEG + 90.0;
+}
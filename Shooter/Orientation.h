@@ -0,0 +1,31 @@
+#ifndef ORIENTATION_H
+#define ORIENTATION_H
+
+// Entity facing is stored as a unit heading vector (dirX, dirY) in world space
+// (+y is down). Sprites are drawn facing up, so the SDL_RenderCopyEx angle is
+// the heading angle + 90 degrees; that conversion is the only place degrees
+// appear. Turning multiplies by a precomputed rotor instead of adding angles.
+
+struct Rotor {
+    float c;    // cos of the turn
+    float s;    // sin of the turn
+};
+
+Rotor MakeRotor(float degrees);
+
+// Rotates (dirX, dirY) in place and pulls it back to unit length
+void RotateDirection(float& dirX, float& dirY, const Rotor& rotor);
+
+// Rotates without modifying the input (spread shots, fans, ...)
+void RotatedDirection(float dirX, float dirY, const Rotor& rotor, float& outX, float& outY);
+
+// Normalises (x, y); leaves it untouched and returns false if it is (near) zero
+bool NormalizeDirection(float& x, float& y);
+
+// Turns (dirX, dirY) a fraction of the way toward the unit vector (targetX, targetY)
+void TurnToward(float& dirX, float& dirY, float targetX, float targetY, float fraction);
+
+// Degrees for SDL_RenderCopyEx
+double DirectionToSpriteAngle(float dirX, float dirY);
+
+#endif
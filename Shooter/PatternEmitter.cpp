@@ -0,0 +1,101 @@
+#include "PatternEmitter.h"
+#include "Globals.h"
+#include "FastMath.h"
+#include "RenderSnapshot.h"
+#include <cmath>
+
+void PatternVolley::LanePosition(int lane, float ticks, float& x, float& y) const {
+    float laneAngle;
+    if (params.shape == PatternShape::RING || params.shape == PatternShape::SPIRAL) {
+        laneAngle = FAST_TWO_PI * lane / params.count;
+    } else {
+        laneAngle = (lane - (params.count - 1) * 0.5f) * params.spread;
+    }
+
+    float sine, cosine;
+    FastSinCos(baseAngle + laneAngle + params.spin * ticks, sine, cosine);
+    float along = params.speed * ticks;
+    float sideways = 0.0f;
+    if (params.waveAmplitude != 0.0f) {
+        // Neighbouring lanes weave in opposite directions
+        sideways = params.waveAmplitude * FastSin(params.waveFrequency * ticks);
+        if (lane & 1) sideways = -sideways;
+    }
+    x = originX + along * cosine - sideways * sine;
+    y = originY + along * sine + sideways * cosine;
+}
+
+bool PatternVolley::MayReach(float x, float y, float reach) const {
+    float inner = params.speed * (age > 0 ? age - 1 : 0);
+    float outer = params.speed * age + params.waveAmplitude;
+    float dx = x - originX;
+    float dy = y - originY;
+    float distSq = dx * dx + dy * dy;
+    float low = inner - reach;
+    float high = outer + reach;
+    if (low > 0.0f && distSq < low * low) return false;
+    return distSq <= high * high;
+}
+
+void PatternEmitter::Emit(const PatternParams& params, float originX, float originY, float aimX, float aimY,
+                          int diameter, int damage, SDL_Texture* texture) {
+    if (params.count <= 0) return;
+
+    PatternVolley volley;
+    volley.originX = originX;
+    volley.originY = originY;
+    volley.baseAngle = FastAtan2(aimY, aimX);
+    volley.age = 0;
+    volley.params = params;
+    if (volley.params.count > PatternVolley::MAX_LANES) volley.params.count = PatternVolley::MAX_LANES;
+    volley.alive = (volley.params.count == PatternVolley::MAX_LANES) ? ~Uint64(0) : (Uint64(1) << volley.params.count) - 1;
+    volley.diameter = diameter;
+    volley.damage = damage;
+    volley.texture = texture;
+    volleys.push_back(volley);
+}
+
+void PatternEmitter::Advance(float maxRange) {
+    for (size_t i = 0; i < volleys.size();) {
+        PatternVolley& volley = volleys[i];
+        volley.age++;
+        if (volley.alive == 0 || volley.params.speed * volley.age > maxRange) {
+            volley = volleys.back();
+            volleys.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
+
+void PatternEmitter::Kill(int volley, int lane) {
+    volleys[volley].alive &= ~(Uint64(1) << lane);
+}
+
+void PatternEmitter::Clear() {
+    volleys.clear();
+}
+
+int PatternEmitter::GetBulletCount() const {
+    int count = 0;
+    for (const PatternVolley& volley : volleys) {
+        for (Uint64 bits = volley.alive; bits; bits &= bits - 1) count++;
+    }
+    return count;
+}
+
+void PatternEmitter::Render(RenderSnapshot& snapshot, float cameraX, float cameraY) const {
+    const float screenReach = 0.5f * std::sqrt(static_cast<float>(SCREEN_WIDTH * SCREEN_WIDTH + SCREEN_HEIGHT * SCREEN_HEIGHT));
+    for (const PatternVolley& volley : volleys) {
+        if (!volley.texture || !volley.MayReach(cameraX, cameraY, screenReach + volley.diameter)) continue;
+        for (int lane = 0; lane < volley.params.count; ++lane) {
+            if (!(volley.alive & (Uint64(1) << lane))) continue;
+            float x, y;
+            volley.LanePosition(lane, static_cast<float>(volley.age), x, y);
+            SDL_Rect rect = { static_cast<int>(x - cameraX + SCREEN_WIDTH / 2 - volley.diameter / 2),
+                              static_cast<int>(y - cameraY + SCREEN_HEIGHT / 2 - volley.diameter / 2),
+                              volley.diameter, volley.diameter };
+            snapshot.AddSprite({volley.texture, rect, 0.0, 255});
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef PATTERNEMITTER_H
+#define PATTERNEMITTER_H
+
+#include <SDL.h>
+#include <vector>
+
+struct RenderSnapshot;
+
+enum class PatternShape {
+    RING,       // evenly around the origin
+    SPIRAL,     // a ring whose arms keep turning as they fly out
+    FAN,        // aimed, 'spread' radians between neighbours
+    WAVE        // a fan whose bullets weave sideways
+};
+
+struct PatternParams {
+    PatternShape shape;
+    int count;              // bullets per volley, at most PatternVolley::MAX_LANES
+    float spread;           // FAN, WAVE: radians between neighbouring lanes
+    float speed;            // pixels per tick along the lane
+    float spin;             // SPIRAL: radians per tick the whole volley turns
+    float waveAmplitude;    // WAVE: pixels to either side
+    float waveFrequency;    // WAVE: radians per tick
+};
+
+// One volley of bullets fired together. Lanes share origin, spawn time and
+// parameters, so a bullet is one bit of 'alive' and its position is worked
+// out from the volley's age instead of being integrated:
+//   angle  = baseAngle + laneAngle + spin * t
+//   centre = origin + speed * t * (cos, sin) + sideways * wave(t)
+// Every lane of a volley is the same distance along its lane, so whole
+// volleys are culled or skipped with one annulus test (MayReach).
+struct PatternVolley {
+    static const int MAX_LANES = 64;
+
+    float originX, originY;
+    float baseAngle;
+    Uint32 age;             // ticks since the volley was fired
+    Uint64 alive;           // bit i set while lane i has not hit anything
+    PatternParams params;
+    int diameter;
+    int damage;
+    SDL_Texture* texture;
+
+    // Centre of 'lane' after 'ticks'
+    void LanePosition(int lane, float ticks, float& x, float& y) const;
+
+    // Could a lane have come within 'reach' of (x, y) during the last tick?
+    // Conservative: false means certainly not.
+    bool MayReach(float x, float y, float reach) const;
+};
+
+// Owns every live volley. Emit is called by the shooter, Advance once per
+// tick before collisions; Game resolves hits lane by lane and calls Kill.
+class PatternEmitter {
+public:
+    std::vector<PatternVolley> volleys;
+
+    void Emit(const PatternParams& params, float originX, float originY, float aimX, float aimY,
+              int diameter, int damage, SDL_Texture* texture);
+    void Advance(float maxRange);   // ages volleys, drops spent and out-of-range ones
+    void Kill(int volley, int lane);
+    void Clear();
+
+    int GetBulletCount() const;
+    void Render(RenderSnapshot& snapshot, float cameraX, float cameraY) const;
+};
+
+#endif
@@ -2,52 +2,63 @@
 #include "Bullet.h"
 #include <iostream>
 #include "Game.h"
+#include "RenderSnapshot.h"
+#include "AllocTracker.h"
+
+// --- Precomputed turns ---
+static const Rotor TURN_LEFT = MakeRotor(-PLAYER_ROTATION_SPEED);
+static const Rotor TURN_RIGHT = MakeRotor(PLAYER_ROTATION_SPEED);
 
 Player::Player(float x, float y, SDL_Texture* selectedTexture, int startingHealth, float speed, Game* game_ptr)
-    : x(x), y(y), vx(0.0f), vy(0.0f), angle(0.0f), width(45), height(45), texture(selectedTexture), game(game_ptr), health(startingHealth), maxHealth(startingHealth), speed(speed), firingRateFactor(3.0f),
-    lastShotTime(0), speedMultiplier(1.0f), shootingPattern(ShootingPattern::SINGLE), level(1), experience(0), experienceToNextLevel(50), bulletType(BulletType::NORMAL) {}
+    : x(x), y(y), vx(0.0f), vy(0.0f), dirX(0.0f), dirY(-1.0f), width(45), height(45), texture(selectedTexture), game(game_ptr), health(startingHealth), maxHealth(startingHealth), speed(speed), firingRateFactor(3.0f),
+    lastShotTime(0), speedMultiplier(1.0f), level(1), experience(0), experienceToNextLevel(50), weapon(nullptr), mask(nullptr) {
+    SelectWeapon();
+}
 
-void Player::HandleInput(const Uint8* keystate, std::vector<Bullet*>& bullets) {
+void Player::HandleInput(const Uint8* keystate) {
     speedMultiplier = (keystate[SDL_SCANCODE_LSHIFT] || keystate[SDL_SCANCODE_RSHIFT]) ? 2.0f : 1.0f;
+    vx = 0.0f;
+    vy = 0.0f;   // Move adds this tick's displacement
 
     if (keystate[SDL_SCANCODE_W]) Move(speed * speedMultiplier);
     if (keystate[SDL_SCANCODE_S]) Move(-speed * speedMultiplier);
-    if (keystate[SDL_SCANCODE_A]) Rotate(-PLAYER_ROTATION_SPEED);
-    if (keystate[SDL_SCANCODE_D]) Rotate(PLAYER_ROTATION_SPEED);
+    if (keystate[SDL_SCANCODE_A]) Rotate(TURN_LEFT);
+    if (keystate[SDL_SCANCODE_D]) Rotate(TURN_RIGHT);
 
     if (keystate[SDL_SCANCODE_SPACE]) {
-        Shoot(bullets, shootingPattern);
+        Shoot();
     }
 }
 
 void Player::Move(float speed) {
-     float radianAngle = (angle - 90) * M_PI / 180.0f;
-
-    float deltaX = speed * cos(radianAngle);
-    float deltaY = speed * sin(radianAngle);
+    float deltaX = speed * dirX;
+    float deltaY = speed * dirY;
 
     // Update player position
     x += deltaX;
     y += deltaY;
+    vx += deltaX;
+    vy += deltaY;
 }
 
-void Player::Rotate(float amount) {
-    angle += amount;
+void Player::Rotate(const Rotor& rotor) {
+    RotateDirection(dirX, dirY, rotor);
 }
 
-void Player::Render(SDL_Renderer* renderer) {
+void Player::Render(RenderSnapshot& snapshot) {
     SDL_Rect rect = { static_cast<int>(SCREEN_WIDTH / 2 - width / 2), static_cast<int>(SCREEN_HEIGHT / 2 - height / 2), width, height };
-    SDL_Point center = { width / 2, height / 2 };
-    SDL_RenderCopyEx(renderer, texture, nullptr, &rect, angle, &center, SDL_FLIP_NONE);
+    snapshot.sprites.push_back({texture, rect, DirectionToSpriteAngle(dirX, dirY), 255});
 }
 
-void Player::Shoot(std::vector<Bullet*>& bullets, ShootingPattern shootingPattern) {
+void Player::Shoot() {
+    AllocScope allocScope(AllocTag::SHOOT);
+    if (!weapon || weapon->shots.empty()) return;
 
     Uint32 currentTime = SDL_GetTicks();
-    if (currentTime - lastShotTime >= (BASE_SHOT_COOLDOWN / firingRateFactor))
+    if (currentTime - lastShotTime >= (weapon->cooldown / firingRateFactor))
     {
         SDL_Texture* selectedBulletTexture = nullptr;
-        switch (this->bulletType) {
+        switch (weapon->bulletType) {
             case BulletType::NORMAL:          selectedBulletTexture = this->game->bulletTexNormal; break;
             case BulletType::POWERED:         selectedBulletTexture = this->game->bulletTexPowered; break;
             case BulletType::SUPER_POWERED:   selectedBulletTexture = this->game->bulletTexSuperPowered; break;
@@ -55,46 +66,18 @@ void Player::Shoot(std::vector<Bullet*>& bullets, ShootingPattern shootingPatter
             default:                          selectedBulletTexture = this->game->bulletTexNormal; break;
         }
 
-        float radianAngle = (angle - 90) * M_PI / 180.0f;
-        float bulletVX = BULLET_SPEED * cos(radianAngle) * speedMultiplier;
-        float bulletVY = BULLET_SPEED * sin(radianAngle) * speedMultiplier;
-        float bulletOffsetX = width / 2.0f * cos(radianAngle);
-        float bulletOffsetY = height / 2.0f * sin(radianAngle);
-        float bulletX = x + bulletOffsetX;
-        float bulletY = y + bulletOffsetY;
-        float bulletDamage = 35;
-        bool Shooted = false;
-        switch (shootingPattern) {
-            case ShootingPattern::SINGLE:
-                bullets.push_back(new Bullet(bulletX, bulletY, bulletVX, bulletVY, selectedBulletTexture, bulletDamage, bulletType));
-                Shooted = true;
-                break;
-            case ShootingPattern::DOUBLE:
-                bullets.push_back(new Bullet(bulletX + 5, bulletY + 5, bulletVX, bulletVY, selectedBulletTexture, bulletDamage, bulletType));
-                bullets.push_back(new Bullet(bulletX - 5, bulletY - 5, bulletVX, bulletVY, selectedBulletTexture, bulletDamage, bulletType));
-                Shooted = true;
-                break;
-            case ShootingPattern::TRIPLE:
-                bullets.push_back(new Bullet(bulletX, bulletY, bulletVX, bulletVY, selectedBulletTexture, bulletDamage, bulletType));
-                bullets.push_back(new Bullet(bulletX, bulletY, BULLET_SPEED * cos((angle - 10 - 90) * M_PI / 180.0f) * speedMultiplier, BULLET_SPEED * sin((angle - 10 - 90) * M_PI / 180.0f) * speedMultiplier, selectedBulletTexture, bulletDamage, bulletType));
-                bullets.push_back(new Bullet(bulletX, bulletY, BULLET_SPEED * cos((angle + 10 - 90) * M_PI / 180.0f) * speedMultiplier, BULLET_SPEED * sin((angle + 10 - 90) * M_PI / 180.0f) * speedMultiplier, selectedBulletTexture, bulletDamage, bulletType));
-                Shooted = true;
-                break;
-            case ShootingPattern::SIDEWAYS:
-                bullets.push_back(new Bullet(bulletX, bulletY, bulletVX, bulletVY, selectedBulletTexture, bulletDamage, bulletType));
-
-                float sidewaysAngleLeft = (angle - 90 - 90) * M_PI / 180.0f;
-                float sidewaysAngleRight = (angle - 90 + 90) * M_PI / 180.0f;
-
-                bullets.push_back(new Bullet(bulletX, bulletY, BULLET_SPEED * cos(sidewaysAngleLeft) * speedMultiplier, BULLET_SPEED * sin(sidewaysAngleLeft) * speedMultiplier, selectedBulletTexture, bulletDamage, bulletType));
-                bullets.push_back(new Bullet(bulletX, bulletY, BULLET_SPEED * cos(sidewaysAngleRight) * speedMultiplier, BULLET_SPEED * sin(sidewaysAngleRight) * speedMultiplier, selectedBulletTexture, bulletDamage, bulletType));
-
-                bullets.push_back(new Bullet(bulletX, bulletY, BULLET_SPEED * cos((angle - 10 - 90) * M_PI / 180.0f) * speedMultiplier, BULLET_SPEED * sin((angle - 10 - 90) * M_PI / 180.0f) * speedMultiplier, selectedBulletTexture, bulletDamage, bulletType));
-                bullets.push_back(new Bullet(bulletX, bulletY, BULLET_SPEED * cos((angle + 10 - 90) * M_PI / 180.0f) * speedMultiplier, BULLET_SPEED * sin((angle + 10 - 90) * M_PI / 180.0f) * speedMultiplier, selectedBulletTexture, bulletDamage, bulletType));
-                Shooted = true;
-                break;
+        float bulletSpeed = BULLET_SPEED * speedMultiplier;
+        float muzzleX = x + width / 2.0f * dirX;
+        float muzzleY = y + height / 2.0f * dirY;
+
+        // Each shot of the weapon turned to the heading: a 2x2 rotation, no trig
+        for (const WeaponShot& shot : weapon->shots) {
+            float shotX, shotY, offsetX, offsetY;
+            AimShot(shot, dirX, dirY, shotX, shotY, offsetX, offsetY);
+            game->SpawnPlayerBullet(muzzleX + offsetX, muzzleY + offsetY, shotX * bulletSpeed, shotY * bulletSpeed,
+                                    selectedBulletTexture, weapon->damage, weapon->bulletType);
         }
-        if (Shooted && game) {
+        if (game) {
              game->PlaySoundEffect(game->playerShootSound);
         }
         lastShotTime = currentTime;
@@ -117,29 +100,19 @@ void Player::LevelUp() {
     maxHealth += maxHealth/4;
     health = maxHealth;
 
-    if (level == 2) {
-        firingRateFactor *= 1.15f;
-        shootingPattern  = ShootingPattern::DOUBLE;
-        bulletType = BulletType::NORMAL;
-    } else if (level == 3) {
-        shootingPattern  = ShootingPattern::TRIPLE;
-        bulletType = BulletType::NORMAL;
-    } else if (level == 4) {
-        firingRateFactor *= 1.15f;
-        shootingPattern  = ShootingPattern::TRIPLE;
-		bulletType = BulletType::POWERED;
-	} else if (level == 5){
-        shootingPattern  = ShootingPattern::SIDEWAYS;
-        bulletType = BulletType::POWERED;
-    } else if (level == 6) {
-        firingRateFactor *= 1.15f;
-        shootingPattern  = ShootingPattern::SIDEWAYS;
-        bulletType = BulletType::SUPER_POWERED;
-    }
-    else if (level >= 7) {
-        shootingPattern  = ShootingPattern::SIDEWAYS;
-        bulletType = BulletType::EXTREME_POWERED;
+    // Weapon and fire rate progression come from the weapon table
+    if (game) {
+        const WeaponLevel* entry = game->weapons.GetLevel(level);
+        if (entry && entry->level == level) firingRateFactor *= entry->fireRateMultiplier;
     }
+    SelectWeapon();
+}
+
+// The weapon table's entry for the current level, without its fire rate bonus
+void Player::SelectWeapon() {
+    if (!game) return;
+    const WeaponLevel* entry = game->weapons.GetLevel(level);
+    weapon = entry ? game->weapons.GetWeapon(*entry) : nullptr;
 }
 
 void Player::TakeDamage(int amount) {
@@ -149,3 +122,7 @@ void Player::TakeDamage(int amount) {
         health = 0;
     }
 }
+
+Circle Player::GetShape() const {
+    return {x + width / 2.0f, y + height / 2.0f, width / 2.0f};
+}
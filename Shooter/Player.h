@@ -5,16 +5,20 @@
 #include <vector>
 #include "Bullet.h"
 #include "Globals.h"
+#include "Orientation.h"
+#include "CollisionShapes.h"
+#include "CollisionMask.h"
+#include "WeaponTable.h"
 #include "Game.h"
 
-class Bullet;
 class Game;
+struct RenderSnapshot;
 
 class Player {
 public:
     float x, y;
     float vx, vy;
-    float angle;
+    float dirX, dirY;   // unit heading, (0, -1) = up
     int width, height;
     SDL_Texture* texture;
     Game* game;
@@ -24,22 +28,24 @@ public:
     float firingRateFactor;
     Uint32 lastShotTime;
     float speedMultiplier;
-    ShootingPattern shootingPattern;
     int level;
     int experience;
     int experienceToNextLevel;
-    BulletType bulletType;
+    const Weapon* weapon;       // from Game::weapons, by level
+    const CollisionMask* mask;  // sprite pixels, null if unavailable
 
     Player(float x, float y, SDL_Texture* selectedTexture, int startingHealth, float speed, Game* game);
 
-    void HandleInput(const Uint8* keystate, std::vector<Bullet*>& bullets);
+    void HandleInput(const Uint8* keystate);
     void Move(float moveSpeed);
-    void Rotate(float amount);
-    void Render(SDL_Renderer* renderer);
-    void Shoot(std::vector<Bullet*>& bullets, ShootingPattern shootingPattern);
+    void Rotate(const Rotor& rotor);
+    void Render(RenderSnapshot& snapshot);
+    void Shoot();
     void AddExperience(int amount);
     void LevelUp();
+    void SelectWeapon();
     void TakeDamage(int amount);
+    Circle GetShape() const;
 };
 
 #endif
@@ -0,0 +1,100 @@
+#include "PoissonTiles.h"
+#include "Globals.h"
+#include <cmath>
+#include <random>
+
+PoissonTiles::PoissonTiles() {
+    Build();
+}
+
+const PoissonTiles& PoissonTiles::Get() {
+    static const PoissonTiles instance;   // thread-safe first use
+    return instance;
+}
+
+const std::vector<PoissonPoint>& PoissonTiles::GetTile(int chunkX, int chunkY) const {
+    // Proper modulo, so negative chunk coords wrap too
+    int tileX = ((chunkX % POISSON_TILE_CHUNKS) + POISSON_TILE_CHUNKS) % POISSON_TILE_CHUNKS;
+    int tileY = ((chunkY % POISSON_TILE_CHUNKS) + POISSON_TILE_CHUNKS) % POISSON_TILE_CHUNKS;
+    return tiles[tileY * POISSON_TILE_CHUNKS + tileX];
+}
+
+void PoissonTiles::Build() {
+    const float period = static_cast<float>(POISSON_TILE_CHUNKS * CHUNK_SIZE);
+    const float radius = MIN_SEPARATION_DISTANCE;
+    const float radiusSq = radius * radius;
+
+    // Background grid with cells small enough to hold one point each, sized to divide the torus evenly
+    const int gridSize = static_cast<int>(std::ceil(period / (radius / std::sqrt(2.0f))));
+    const float cellSize = period / gridSize;
+    std::vector<int> grid(gridSize * gridSize, -1);
+    std::vector<PoissonPoint> points;
+    std::vector<int> activeList;
+
+    std::mt19937 rng(0x5EED7113u);   // fixed: the world seed picks among sites, not the sites themselves
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    auto wrap = [period](float value) {
+        value = std::fmod(value, period);
+        return value < 0.0f ? value + period : value;
+    };
+    auto cellOf = [cellSize, gridSize](float value) {
+        return std::min(static_cast<int>(value / cellSize), gridSize - 1);
+    };
+    auto add = [&](float x, float y) {
+        grid[cellOf(y) * gridSize + cellOf(x)] = static_cast<int>(points.size());
+        activeList.push_back(static_cast<int>(points.size()));
+        points.push_back({x, y});
+    };
+    auto fits = [&](float x, float y) {
+        int cellX = cellOf(x);
+        int cellY = cellOf(y);
+        for (int dy = -2; dy <= 2; ++dy) {
+            for (int dx = -2; dx <= 2; ++dx) {
+                int nx = (cellX + dx + gridSize) % gridSize;
+                int ny = (cellY + dy + gridSize) % gridSize;
+                int other = grid[ny * gridSize + nx];
+                if (other < 0) continue;
+                // Shortest distance on the torus
+                float ox = std::fabs(points[other].x - x);
+                float oy = std::fabs(points[other].y - y);
+                ox = std::min(ox, period - ox);
+                oy = std::min(oy, period - oy);
+                if (ox * ox + oy * oy < radiusSq) return false;
+            }
+        }
+        return true;
+    };
+
+    add(unit(rng) * period, unit(rng) * period);
+    while (!activeList.empty()) {
+        int pick = static_cast<int>(unit(rng) * activeList.size()) % static_cast<int>(activeList.size());
+        const PoissonPoint origin = points[activeList[pick]];
+
+        bool placed = false;
+        for (int attempt = 0; attempt < POISSON_CANDIDATES; ++attempt) {
+            // Uniform in the annulus [r, 2r)
+            float angle = unit(rng) * 6.2831853f;
+            float distance = radius * std::sqrt(1.0f + 3.0f * unit(rng));
+            float x = wrap(origin.x + std::cos(angle) * distance);
+            float y = wrap(origin.y + std::sin(angle) * distance);
+            if (fits(x, y)) {
+                add(x, y);
+                placed = true;
+                break;
+            }
+        }
+        if (!placed) {
+            activeList[pick] = activeList.back();
+            activeList.pop_back();
+        }
+    }
+
+    // --- Cut the torus into per-chunk tiles ---
+    tiles.assign(POISSON_TILE_CHUNKS * POISSON_TILE_CHUNKS, std::vector<PoissonPoint>());
+    for (const auto& point : points) {
+        int tileX = std::min(static_cast<int>(point.x / CHUNK_SIZE), POISSON_TILE_CHUNKS - 1);
+        int tileY = std::min(static_cast<int>(point.y / CHUNK_SIZE), POISSON_TILE_CHUNKS - 1);
+        tiles[tileY * POISSON_TILE_CHUNKS + tileX].push_back({point.x - tileX * CHUNK_SIZE, point.y - tileY * CHUNK_SIZE});
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef POISSONTILES_H
+#define POISSONTILES_H
+
+#include <vector>
+
+struct PoissonPoint {
+    float x, y;     // relative to the chunk's top-left corner
+};
+
+// Blue-noise obstacle sites, computed once. Bridson's algorithm fills a
+// torus POISSON_TILE_CHUNKS chunks on a side with points at least
+// MIN_SEPARATION_DISTANCE apart (wrap-around distance), which is then cut
+// into one tile per chunk. Because the torus wraps, the tiles line up with
+// each other across every chunk border, so any subset of them drawn for
+// neighbouring chunks keeps the spacing. Sites are obstacle centres: two
+// obstacles at the largest size (150 px) still do not overlap.
+//
+// Built on first use and read-only afterwards, so the chunk generator thread
+// can read it without locking.
+class PoissonTiles {
+public:
+    static const PoissonTiles& Get();
+
+    const std::vector<PoissonPoint>& GetTile(int chunkX, int chunkY) const;
+
+private:
+    PoissonTiles();
+
+    void Build();
+
+    std::vector<std::vector<PoissonPoint>> tiles;   // POISSON_TILE_CHUNKS^2, row-major
+};
+
+#endif
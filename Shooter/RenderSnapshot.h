@@ -0,0 +1,75 @@
+#ifndef RENDERSNAPSHOT_H
+#define RENDERSNAPSHOT_H
+
+#include <SDL.h>
+#include <vector>
+#include "Globals.h"
+#include "AllocTracker.h"
+
+// One textured quad in screen space, drawn with SDL_RenderCopyEx
+struct Sprite {
+    SDL_Texture* texture;
+    SDL_Rect dest;
+    double angle;
+    Uint8 alpha;
+};
+
+struct HudValues {
+    int health;
+    int maxHealth;
+    int experience;
+    int experienceToNextLevel;
+    int level;
+    int stageNumber;
+    int killCount;
+    int killGoal;           // 0 on an endless stage
+};
+
+// Entity counts and timings, drawn when toggled with F3 (always in Horde)
+struct StatsValues {
+    bool visible;
+    int enemies;
+    int playerBullets;
+    int enemyBullets;
+    int patternBullets;
+    int volleys;
+    int obstacles;
+    int turrets;            // hostile obstacles
+    int orbs;
+    int sprites;            // what survived culling
+    float simulationMs;     // last UpdatePlayingState
+    int arenaKB;            // simulation frame arena, last finished frame
+    int arenaPeakKB;
+    int arenaOverflows;     // heap fallbacks in that frame
+    bool allocTracking;     // built with TRACK_ALLOCATIONS
+    AllocFrameStats heap;   // last finished frame
+};
+
+// Everything the render thread needs for one frame. Built by the simulation at
+// the end of Game::Update and handed over through a TripleBuffer, so the render
+// thread never touches live game objects.
+struct RenderSnapshot {
+    GameState state;
+    int selectedMenuOption;
+    Uint32 creditsStartTime;
+
+    bool hasPlayer;
+    float cameraX, cameraY;
+    std::vector<Sprite> sprites;   // in draw order, player last
+    HudValues hud;
+    StatsValues stats;
+
+    RenderSnapshot() : state(GameState::MAIN_MENU), selectedMenuOption(0), creditsStartTime(0),
+                       hasPlayer(false), cameraX(0.0f), cameraY(0.0f), hud(), stats() {}
+
+    // Drops sprites that cannot reach the screen, whatever their rotation,
+    // so a large horde off screen costs neither copies nor draw calls
+    void AddSprite(const Sprite& sprite) {
+        int reach = (sprite.dest.w > sprite.dest.h ? sprite.dest.w : sprite.dest.h) / 4;   // rotated corners stick out
+        if (sprite.dest.x + sprite.dest.w + reach < 0 || sprite.dest.x - reach > SCREEN_WIDTH ||
+            sprite.dest.y + sprite.dest.h + reach < 0 || sprite.dest.y - reach > SCREEN_HEIGHT) return;
+        sprites.push_back(sprite);
+    }
+};
+
+#endif
@@ -0,0 +1,86 @@
+#include "SpatialGrid.h"
+#include <cmath>
+#include <algorithm>
+
+static const int MIN_BUCKET_COUNT = 1024;   // power of two
+
+SpatialGrid::SpatialGrid(float cellSize_in)
+    : cellSize(cellSize_in), invCellSize(1.0f / cellSize_in),
+      bucketMask(MIN_BUCKET_COUNT - 1), bucketStart(MIN_BUCKET_COUNT + 1, 0), queryStamp(0) {}
+
+void SpatialGrid::Clear() {
+    entries.clear();
+    sortedIds.clear();
+}
+
+int SpatialGrid::CellCoord(float value) const {
+    return static_cast<int>(std::floor(value * invCellSize));
+}
+
+int SpatialGrid::BucketOf(int cellX, int cellY) const {
+    unsigned int hash = static_cast<unsigned int>(cellX) * 73856093u ^ static_cast<unsigned int>(cellY) * 19349663u;
+    return static_cast<int>(hash & static_cast<unsigned int>(bucketMask));
+}
+
+void SpatialGrid::Insert(int id, float x, float y, float radius) {
+    int minX = CellCoord(x - radius);
+    int maxX = CellCoord(x + radius);
+    int minY = CellCoord(y - radius);
+    int maxY = CellCoord(y + radius);
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            entries.push_back({id, cx, cy});
+        }
+    }
+    if (id >= static_cast<int>(stamps.size())) stamps.resize(id + 1, 0);
+}
+
+void SpatialGrid::Build() {
+    // At least twice as many buckets as entries keeps collisions rare
+    int bucketCount = MIN_BUCKET_COUNT;
+    while (bucketCount < static_cast<int>(entries.size()) * 2) bucketCount *= 2;
+    bucketMask = bucketCount - 1;
+
+    // Counting sort of the entries by bucket
+    bucketStart.assign(bucketCount + 1, 0);
+    for (const Entry& entry : entries) {
+        bucketStart[BucketOf(entry.cellX, entry.cellY) + 1]++;
+    }
+    for (int b = 0; b < bucketCount; ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+
+    sortedIds.resize(entries.size());
+    bucketCursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+    for (const Entry& entry : entries) {
+        sortedIds[bucketCursor[BucketOf(entry.cellX, entry.cellY)]++] = entry.id;
+    }
+}
+
+void SpatialGrid::Query(float x, float y, float radius, std::vector<int>& out) {
+    if (++queryStamp == 0) {
+        // Wrapped around; old stamps could collide with the new ones
+        std::fill(stamps.begin(), stamps.end(), 0);
+        queryStamp = 1;
+    }
+
+    int minX = CellCoord(x - radius);
+    int maxX = CellCoord(x + radius);
+    int minY = CellCoord(y - radius);
+    int maxY = CellCoord(y + radius);
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            int bucket = BucketOf(cx, cy);
+            for (int i = bucketStart[bucket]; i < bucketStart[bucket + 1]; ++i) {
+                int id = sortedIds[i];
+                if (stamps[id] == queryStamp) continue;
+                stamps[id] = queryStamp;
+                out.push_back(id);
+            }
+        }
+    }
+}
+
+float SpatialGrid::GetCellSize() const {
+    return cellSize;
+}
@@ -0,0 +1,45 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <vector>
+
+// Uniform grid over an unbounded world, hashed into a bucket table sized to
+// the item count and rebuilt from scratch each frame. Items are circles; one bigger than a cell
+// (TANK, BOSS) goes into every cell its bounding box touches, so queries only
+// ever look at the cells they overlap. Multi-cell items and hash collisions
+// would show up more than once per query; a per-item stamp drops the
+// repeats. Callers still do the exact distance test.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize);
+
+    void Clear();
+    void Insert(int id, float x, float y, float radius);
+    void Build();   // call once after the inserts, before queries
+
+    // Appends the ids of items whose cells overlap the query circle's box
+    void Query(float x, float y, float radius, std::vector<int>& out);
+
+    float GetCellSize() const;
+
+private:
+    int BucketOf(int cellX, int cellY) const;
+    int CellCoord(float value) const;
+
+    struct Entry {
+        int id;
+        int cellX, cellY;
+    };
+
+    float cellSize;
+    float invCellSize;
+    std::vector<Entry> entries;
+    int bucketMask;                   // bucket count - 1, a power of two
+    std::vector<int> bucketStart;     // bucket count + 1 prefix sums after Build
+    std::vector<int> bucketCursor;
+    std::vector<int> sortedIds;
+    std::vector<int> stamps;          // indexed by id
+    int queryStamp;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#include "SpawnTable.h"
+
+SpawnTable::SpawnTable() : columnCount(0) {
+    for (int i = 0; i < ENEMY_TYPE_COUNT; ++i) {
+        keep[i] = 1.0f;
+        outcome[i] = 0;
+        alias[i] = 0;
+    }
+}
+
+void SpawnTable::Build(const int weights[ENEMY_TYPE_COUNT]) {
+    columnCount = 0;
+    int total = 0;
+    for (int type = 0; type < ENEMY_TYPE_COUNT; ++type) {
+        if (weights[type] <= 0) continue;
+        outcome[columnCount++] = static_cast<Uint8>(type);
+        total += weights[type];
+    }
+    if (columnCount == 0) {
+        columnCount = 1;
+        outcome[0] = static_cast<Uint8>(EnemyType::NORMAL);
+        keep[0] = 1.0f;
+        alias[0] = 0;
+        return;
+    }
+
+    // Scale so the average column holds exactly 1, then pair each short
+    // column with a tall one that tops it up
+    float scaled[ENEMY_TYPE_COUNT];
+    int small[ENEMY_TYPE_COUNT], large[ENEMY_TYPE_COUNT];
+    int smallCount = 0, largeCount = 0;
+    for (int i = 0; i < columnCount; ++i) {
+        scaled[i] = static_cast<float>(weights[outcome[i]]) * columnCount / total;
+        if (scaled[i] < 1.0f) small[smallCount++] = i;
+        else large[largeCount++] = i;
+    }
+    while (smallCount > 0 && largeCount > 0) {
+        int shortColumn = small[--smallCount];
+        int tallColumn = large[--largeCount];
+        keep[shortColumn] = scaled[shortColumn];
+        alias[shortColumn] = static_cast<Uint8>(tallColumn);
+        scaled[tallColumn] -= 1.0f - scaled[shortColumn];
+        if (scaled[tallColumn] < 1.0f) small[smallCount++] = tallColumn;
+        else large[largeCount++] = tallColumn;
+    }
+    // Whatever is left is 1 up to rounding
+    while (largeCount > 0) { int i = large[--largeCount]; keep[i] = 1.0f; alias[i] = static_cast<Uint8>(i); }
+    while (smallCount > 0) { int i = small[--smallCount]; keep[i] = 1.0f; alias[i] = static_cast<Uint8>(i); }
+}
+
+EnemyType SpawnTable::Sample(int column, float coin) const {
+    int chosen = (coin < keep[column]) ? column : alias[column];
+    return static_cast<EnemyType>(outcome[chosen]);
+}
+
+int SpawnTable::GetColumnCount() const {
+    return columnCount;
+}
@@ -0,0 +1,29 @@
+#ifndef SPAWNTABLE_H
+#define SPAWNTABLE_H
+
+#include <SDL_stdinc.h>
+#include "Globals.h"
+
+// Weighted choice of enemy type in O(1), Walker/Vose alias method: one
+// column per type with nonzero weight; a draw picks a column uniformly and
+// keeps it with probability 'keep', otherwise takes its alias. Built once
+// when stages are loaded, so spawning never walks a cumulative table.
+class SpawnTable {
+public:
+    SpawnTable();
+
+    // weights[type] >= 0; an all-zero table always yields NORMAL
+    void Build(const int weights[ENEMY_TYPE_COUNT]);
+
+    // column: uniform in [0, GetColumnCount()), coin: uniform in [0, 1)
+    EnemyType Sample(int column, float coin) const;
+    int GetColumnCount() const;
+
+private:
+    int columnCount;
+    float keep[ENEMY_TYPE_COUNT];
+    Uint8 outcome[ENEMY_TYPE_COUNT];
+    Uint8 alias[ENEMY_TYPE_COUNT];
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <utility>
+
+// Lock-free single-producer / single-consumer ring of Capacity - 1 items
+// (Capacity must be a power of two). The producer only writes 'tail' and the
+// consumer only writes 'head', so each index has a single owner and a
+// release store / acquire load pair is all the synchronisation needed.
+// Items are moved in and out, so slots may own heap memory.
+template <typename T, int Capacity>
+class SpscQueue {
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // --- Producer side ---
+    bool Push(T&& item) {
+        int current = tail.load(std::memory_order_relaxed);
+        int next = (current + 1) & MASK;
+        if (next == head.load(std::memory_order_acquire)) return false;   // full
+        slots[current] = std::move(item);
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // --- Consumer side ---
+    bool Pop(T& out) {
+        int current = head.load(std::memory_order_relaxed);
+        if (current == tail.load(std::memory_order_acquire)) return false;   // empty
+        out = std::move(slots[current]);
+        head.store((current + 1) & MASK, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+    static const int MASK = Capacity - 1;
+
+    T slots[Capacity];
+    std::atomic<int> head;
+    std::atomic<int> tail;
+};
+
+#endif
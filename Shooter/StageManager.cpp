@@ -1,42 +1,212 @@
 #include "StageManager.h"
 #include "Enemy.h"
 #include "Player.h"
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <vector>
-#include <map>
 
-StageManager::StageManager() : currentStageIndex(-1), currentKillCount(0), gameWon(false) {
-    LoadStages();
+// Same content as assets/stages.txt, used when the file cannot be read
+static const char* const DEFAULT_STAGES =
+    "mode CAMPAIGN\n"
+    "stage 1 10 2000 1\n"
+    "spawn NORMAL 900\n"
+    "spawn FAST 100\n"
+    "stage 2 20 1800 1\n"
+    "spawn NORMAL 600\n"
+    "spawn FAST 300\n"
+    "spawn QUICK 100\n"
+    "stage 3 30 1600 2\n"
+    "spawn NORMAL 300\n"
+    "spawn FAST 350\n"
+    "spawn QUICK 250\n"
+    "spawn TANK 100\n"
+    "stage 4 50 1400 2\n"
+    "spawn NORMAL 150\n"
+    "spawn FAST 250\n"
+    "spawn QUICK 340\n"
+    "spawn TANK 250\n"
+    "boss 10\n"
+    "stage 5 70 1300 3\n"
+    "spawn NORMAL 60\n"
+    "spawn FAST 230\n"
+    "spawn QUICK 400\n"
+    "spawn TANK 300\n"
+    "boss 10\n"
+    "stage 6 100 1200 3\n"
+    "spawn FAST 200\n"
+    "spawn QUICK 350\n"
+    "spawn TANK 420\n"
+    "boss 30\n"
+    "mode HORDE\n"
+    "stage 1 50 500 10 200\n"
+    "spawn NORMAL 700\n"
+    "spawn FAST 300\n"
+    "stage 2 150 400 20 500\n"
+    "spawn NORMAL 500\n"
+    "spawn FAST 300\n"
+    "spawn QUICK 200\n"
+    "wave 20000 FAST 40\n"
+    "stage 3 400 300 30 1000\n"
+    "spawn NORMAL 400\n"
+    "spawn FAST 300\n"
+    "spawn QUICK 200\n"
+    "spawn TANK 100\n"
+    "wave 30000 TANK 20\n"
+    "stage 4 1000 250 40 2000\n"
+    "spawn NORMAL 300\n"
+    "spawn FAST 300\n"
+    "spawn QUICK 250\n"
+    "spawn TANK 150\n"
+    "boss 5\n"
+    "wave 45000 QUICK 100\n"
+    "stage 5 2500 200 50 3000\n"
+    "spawn NORMAL 250\n"
+    "spawn FAST 300\n"
+    "spawn QUICK 250\n"
+    "spawn TANK 200\n"
+    "boss 5\n"
+    "stage 6 0 150 60 4000\n"
+    "spawn NORMAL 250\n"
+    "spawn FAST 300\n"
+    "spawn QUICK 250\n"
+    "spawn TANK 200\n"
+    "boss 5\n"
+    "wave 60000 TANK 200\n";
+
+static bool ParseEnemyType(const std::string& text, EnemyType& type) {
+    if (text == "NORMAL") { type = EnemyType::NORMAL; return true; }
+    if (text == "FAST")   { type = EnemyType::FAST; return true; }
+    if (text == "TANK")   { type = EnemyType::TANK; return true; }
+    if (text == "QUICK")  { type = EnemyType::QUICK; return true; }
+    if (text == "BOSS")   { type = EnemyType::BOSS; return true; }
+    return false;
+}
+
+// Per-mille chances as the old spawn code rolled them: one roll in [0, 1000),
+// the boss chance off the bottom, then the types stacked in enum order, the
+// remainder NORMAL. Each outcome's weight is the part of the roll it owns.
+static void CompileSpawnTable(const int perMille[ENEMY_TYPE_COUNT], int bossChance, SpawnTable& table) {
+    const int ROLL = 1000;
+    int weights[ENEMY_TYPE_COUNT] = {0};
+    int bossCut = std::min(std::max(bossChance, 0), ROLL);
+    weights[static_cast<int>(EnemyType::BOSS)] = bossCut;
+
+    int start = 0;
+    for (int type = 0; type < static_cast<int>(EnemyType::BOSS); ++type) {
+        int end = start + perMille[type];
+        weights[type] += std::max(0, std::min(end, ROLL) - std::max(start, bossCut));
+        start = end;
+    }
+    weights[static_cast<int>(EnemyType::NORMAL)] += std::max(0, ROLL - std::max(start, bossCut));
+    table.Build(weights);
 }
 
-void StageManager::LoadStages() {
-    stages.clear();
+StageManager::StageManager() : mode(GameMode::CAMPAIGN), currentStageIndex(-1), currentKillCount(0), gameWon(false),
+                               stageStartTime(0), nextWave(0) {
+    LoadStages("assets/stages.txt");
+}
+
+bool StageManager::LoadStages(const char* path) {
+    for (auto& stages : stageSets) stages.clear();
+
+    std::ifstream file(path);
+    if (file) {
+        ParseStages(file, path);
+    } else {
+        std::cerr << "StageManager: cannot open " << path << ", using built-in stages" << std::endl;
+        std::istringstream builtIn(DEFAULT_STAGES);
+        ParseStages(builtIn, "built-in stages");
+    }
+
+    std::cout << "Loaded " << stageSets[static_cast<int>(GameMode::CAMPAIGN)].size() << " stages, "
+              << stageSets[static_cast<int>(GameMode::HORDE)].size() << " horde stages." << std::endl;
+    return file.is_open();
+}
 
-    // Stage 1
-    stages.push_back({ 1, 10, 2000, 1, {{EnemyType::NORMAL, 900}, {EnemyType::FAST, 100}}, false, 0 });
+void StageManager::ParseStages(std::istream& in, const char* source) {
+    std::vector<StageData>* target = &stageSets[static_cast<int>(GameMode::CAMPAIGN)];
+    int perMille[ENEMY_TYPE_COUNT] = {0};
+    int bossChance = 0;
 
-    // Stage 2
-    stages.push_back({ 2, 20, 1800, 1, {{EnemyType::NORMAL, 600}, {EnemyType::FAST, 300}, {EnemyType::QUICK, 100}}, false, 0 });
+    // A stage's spawn table is compiled once its last line has been read
+    auto finishStage = [&]() {
+        if (target->empty()) return;
+        StageData& stage = target->back();
+        CompileSpawnTable(perMille, bossChance, stage.spawnTable);
+        std::stable_sort(stage.waves.begin(), stage.waves.end(),
+                         [](const WaveEvent& a, const WaveEvent& b) { return a.time < b.time; });
+    };
 
-    // Stage 3
-    stages.push_back({ 3, 30, 1600, 2, {{EnemyType::NORMAL, 300}, {EnemyType::FAST, 350}, {EnemyType::QUICK, 250}, {EnemyType::TANK, 100}}, false, 0 });
+    std::string line;
+    int lineNumber = 0;
+    bool inStage = false;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword) || keyword[0] == '#') continue;
 
-    // Stage 4
-    stages.push_back({ 4, 50, 1400, 2, {{EnemyType::NORMAL, 150}, {EnemyType::FAST, 250}, {EnemyType::QUICK, 340}, {EnemyType::TANK, 250}}, true, 10 });
+        bool ok = false;
+        if (keyword == "mode") {
+            std::string name;
+            ok = static_cast<bool>(fields >> name) && (name == "CAMPAIGN" || name == "HORDE");
+            if (ok) {
+                if (inStage) finishStage();
+                inStage = false;
+                target = &stageSets[static_cast<int>(name == "HORDE" ? GameMode::HORDE : GameMode::CAMPAIGN)];
+            }
+        } else if (keyword == "stage") {
+            StageData stage = {0, 0, 0, 0, MAX_ENEMIES, SpawnTable(), {}};
+            ok = static_cast<bool>(fields >> stage.stageNumber >> stage.killGoal >> stage.spawnInterval >> stage.baseSpawnCount);
+            if (ok) {
+                int cap;
+                if (fields >> cap) stage.enemyCap = std::min(cap, HORDE_MAX_ENEMIES);
+                if (inStage) finishStage();
+                inStage = true;
+                std::fill(perMille, perMille + ENEMY_TYPE_COUNT, 0);
+                bossChance = 0;
+                target->push_back(stage);
+            }
+        } else if (keyword == "spawn") {
+            std::string typeName;
+            EnemyType type;
+            int chance;
+            ok = inStage && (fields >> typeName >> chance) && ParseEnemyType(typeName, type) && type != EnemyType::BOSS;
+            if (ok) perMille[static_cast<int>(type)] = chance;
+        } else if (keyword == "boss") {
+            ok = inStage && static_cast<bool>(fields >> bossChance);
+        } else if (keyword == "wave") {
+            std::string typeName;
+            WaveEvent wave;
+            ok = inStage && (fields >> wave.time >> typeName >> wave.count) && ParseEnemyType(typeName, wave.type);
+            if (ok) target->back().waves.push_back(wave);
+        }
 
-    // Stage 5
-    stages.push_back({ 5, 70, 1300, 3, {{EnemyType::NORMAL, 60}, {EnemyType::FAST, 230}, {EnemyType::QUICK, 400}, {EnemyType::TANK, 300}}, true, 10 });
+        if (!ok) {
+            std::cerr << "StageManager: " << source << ":" << lineNumber << ": cannot parse '" << line << "'" << std::endl;
+        }
+    }
+    if (inStage) finishStage();
+}
 
-    // Stage 6
-    stages.push_back({ 6, 100, 1200, 3, {{EnemyType::FAST, 200}, {EnemyType::QUICK, 350}, {EnemyType::TANK, 420}}, true, 30 });
+const std::vector<StageData>& StageManager::Stages() const {
+    return stageSets[static_cast<int>(mode)];
+}
 
-    std::cout << "Loaded " << stages.size() << " stages." << std::endl;
+void StageManager::BeginStage() {
+    stageStartTime = SDL_GetTicks();
+    nextWave = 0;
 }
 
-void StageManager::StartGame() {
+void StageManager::StartGame(GameMode newMode) {
+    mode = newMode;
+    const std::vector<StageData>& stages = Stages();
     currentStageIndex = 0;
     currentKillCount = 0;
     gameWon = false;
+    BeginStage();
     if (stages.empty()) {
         std::cerr << "Error: No stages loaded in StageManager!" << std::endl;
     } else {
@@ -45,17 +215,19 @@ void StageManager::StartGame() {
 }
 
 void StageManager::AdvanceStage(Player* player) {
+    const std::vector<StageData>& stages = Stages();
     if (currentStageIndex < 0 || stages.empty()) {
          std::cerr << "Error: Cannot advance stage, game not started or no stages loaded." << std::endl;
          return;
     }
 
-    if (currentStageIndex + 1 >= stages.size()) {
+    if (currentStageIndex + 1 >= static_cast<int>(stages.size())) {
         std::cout << "Final stage cleared! Game Won!" << std::endl;
         gameWon = true;
     } else {
         currentStageIndex++;
         currentKillCount = 0;
+        BeginStage();
 
         // Apply Player Buffs
         if (player) {
@@ -75,16 +247,19 @@ void StageManager::RecordKill() {
 }
 
 bool StageManager::ShouldAdvanceStage() const {
-    if (currentStageIndex < 0 || currentStageIndex >= stages.size() || gameWon) {
+    const std::vector<StageData>& stages = Stages();
+    if (currentStageIndex < 0 || currentStageIndex >= static_cast<int>(stages.size()) || gameWon) {
         return false;
     }
+    if (stages[currentStageIndex].killGoal <= 0) return false;   // endless
     return currentKillCount >= stages[currentStageIndex].killGoal;
 }
 
 const StageData& StageManager::GetCurrentStageData() const {
-    if (currentStageIndex < 0 || currentStageIndex >= stages.size()) {
+    const std::vector<StageData>& stages = Stages();
+    if (currentStageIndex < 0 || currentStageIndex >= static_cast<int>(stages.size())) {
         if (stages.empty()) {
-             static StageData emptyStage = {0, 0, 0, 0, {}, false, 0};
+             static StageData emptyStage = {0, 0, 0, 0, 0, SpawnTable(), {}};
              std::cerr << "Error: GetCurrentStageData called with no stages loaded!" << std::endl;
              return emptyStage;
         }
@@ -95,7 +270,8 @@ const StageData& StageManager::GetCurrentStageData() const {
 }
 
 int StageManager::GetCurrentStageNumber() const {
-     if (currentStageIndex < 0 || currentStageIndex >= stages.size()) {
+    const std::vector<StageData>& stages = Stages();
+     if (currentStageIndex < 0 || currentStageIndex >= static_cast<int>(stages.size())) {
          return 0;
      }
     return stages[currentStageIndex].stageNumber;
@@ -106,7 +282,8 @@ int StageManager::GetCurrentKillCount() const {
 }
 
 int StageManager::GetCurrentKillGoal() const {
-     if (currentStageIndex < 0 || currentStageIndex >= stages.size()) {
+    const std::vector<StageData>& stages = Stages();
+     if (currentStageIndex < 0 || currentStageIndex >= static_cast<int>(stages.size())) {
          return 0;
      }
     return stages[currentStageIndex].killGoal;
@@ -115,3 +292,16 @@ int StageManager::GetCurrentKillGoal() const {
 bool StageManager::IsGameWon() const {
     return gameWon;
 }
+
+GameMode StageManager::GetMode() const {
+    return mode;
+}
+
+const WaveEvent* StageManager::NextDueWave(Uint32 now) {
+    const std::vector<StageData>& stages = Stages();
+    if (currentStageIndex < 0 || currentStageIndex >= static_cast<int>(stages.size()) || gameWon) return nullptr;
+
+    const std::vector<WaveEvent>& waves = stages[currentStageIndex].waves;
+    if (nextWave >= static_cast<int>(waves.size()) || now - stageStartTime < waves[nextWave].time) return nullptr;
+    return &waves[nextWave++];
+}
@@ -1,20 +1,30 @@
 #ifndef STAGEMANAGER_H
 #define STAGEMANAGER_H
 
+#include <istream>
 #include <vector>
-#include <map>
-#include <SDL_stdinc.h>
+#include <SDL.h>
+#include "Globals.h"
+#include "SpawnTable.h"
 
-enum class EnemyType;
+// A scripted batch, 'time' ms after the stage starts
+struct WaveEvent {
+    Uint32 time;
+    EnemyType type;
+    int count;
+};
 
+// One stage as loaded from assets/stages.txt. The spawn chances and boss
+// chance are compiled into spawnTable (BOSS there means "a boss, or a TANK
+// while one is alive").
 struct StageData {
     int stageNumber;
-    int killGoal;
+    int killGoal;           // 0: endless
     Uint32 spawnInterval;
     int baseSpawnCount;
-    std::map<EnemyType, int> spawnProbabilities;
-    bool canSpawnBoss;
-    int bossSpawnChance;
+    int enemyCap;           // no spawns while this many enemies are alive
+    SpawnTable spawnTable;
+    std::vector<WaveEvent> waves;   // by time
 };
 
 class Player;
@@ -23,9 +33,9 @@ class StageManager {
 public:
     StageManager();
 
-    void LoadStages();
+    bool LoadStages(const char* path);
 
-    void StartGame();
+    void StartGame(GameMode mode = GameMode::CAMPAIGN);
     void AdvanceStage(Player* player);
 
     void RecordKill();
@@ -37,12 +47,23 @@ public:
     int GetCurrentKillCount() const;
     int GetCurrentKillGoal() const;
     bool IsGameWon() const;
+    GameMode GetMode() const;
+
+    // Next scripted wave of the current stage that is due at 'now', or null
+    const WaveEvent* NextDueWave(Uint32 now);
 
 private:
-    std::vector<StageData> stages;
+    void ParseStages(std::istream& in, const char* source);
+    const std::vector<StageData>& Stages() const;
+    void BeginStage();
+
+    GameMode mode;
+    std::vector<StageData> stageSets[2];    // by GameMode
     int currentStageIndex;
     int currentKillCount;
     bool gameWon;
+    Uint32 stageStartTime;
+    int nextWave;
 };
 
 #endif
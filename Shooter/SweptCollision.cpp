@@ -0,0 +1,58 @@
+#include "SweptCollision.h"
+
+// Clips [tEnter, tExit] against one axis slab
+static bool ClipSlab(float start, float delta, float slabMin, float slabMax, float& tEnter, float& tExit) {
+    if (delta == 0.0f) {
+        // Moving parallel to the slab: inside for the whole path or never
+        return start > slabMin && start < slabMax;
+    }
+    float t0 = (slabMin - start) / delta;
+    float t1 = (slabMax - start) / delta;
+    if (t0 > t1) {
+        float swap = t0;
+        t0 = t1;
+        t1 = swap;
+    }
+    if (t0 > tEnter) tEnter = t0;
+    if (t1 < tExit) tExit = t1;
+    return tEnter < tExit;
+}
+
+bool SweepCircleVsCircle(float fromX, float fromY, float toX, float toY, float radius, const Circle& target, float& hitTime) {
+    float reach = radius + target.radius;
+    float startX = fromX - target.x;
+    float startY = fromY - target.y;
+    float c = startX * startX + startY * startY - reach * reach;
+    if (c < 0.0f) {
+        hitTime = 0.0f;   // already overlapping
+        return true;
+    }
+
+    // |start + t * delta| = reach, smallest root in [0, 1]
+    float deltaX = toX - fromX;
+    float deltaY = toY - fromY;
+    float a = deltaX * deltaX + deltaY * deltaY;
+    float b = startX * deltaX + startY * deltaY;
+    if (a == 0.0f || b >= 0.0f) return false;   // not moving, or moving away
+    float discriminant = b * b - a * c;
+    if (discriminant <= 0.0f) return false;
+    float t = (-b - std::sqrt(discriminant)) / a;
+    if (t > 1.0f) return false;
+    hitTime = t;
+    return true;
+}
+
+bool SweepCircleVsObb(float fromX, float fromY, float toX, float toY, float radius, const Obb& target, float& hitTime) {
+    float startX, startY, endX, endY;
+    ToObbLocal(target, fromX, fromY, startX, startY);
+    ToObbLocal(target, toX, toY, endX, endY);
+
+    float tEnter = 0.0f;
+    float tExit = 1.0f;
+    float reachX = target.halfW + radius;
+    float reachY = target.halfH + radius;
+    if (!ClipSlab(startX, endX - startX, -reachX, reachX, tEnter, tExit)) return false;
+    if (!ClipSlab(startY, endY - startY, -reachY, reachY, tEnter, tExit)) return false;
+    hitTime = tEnter;
+    return true;
+}
@@ -0,0 +1,32 @@
+#ifndef SWEPTCOLLISION_H
+#define SWEPTCOLLISION_H
+
+#include "CollisionShapes.h"
+
+// Continuous tests for a circle whose centre moves from (fromX, fromY) to
+// (toX, toY) over one tick. Each returns true if the circle overlaps the
+// target anywhere along the path, with hitTime the fraction of the path
+// (0..1) at first contact. Touching does not count.
+
+// Circle vs circle: the path against a circle of the summed radius
+bool SweepCircleVsCircle(float fromX, float fromY, float toX, float toY, float radius, const Circle& target, float& hitTime);
+
+// Circle vs box: the path, in the box's frame, against the box grown by the
+// radius. The grown corners are square, so a path that only clips a corner
+// can count as a hit up to radius * (sqrt(2) - 1) early.
+bool SweepCircleVsObb(float fromX, float fromY, float toX, float toY, float radius, const Obb& target, float& hitTime);
+
+inline bool SweepCircle(float fromX, float fromY, float toX, float toY, float radius, const Circle& target, float& hitTime) {
+    return SweepCircleVsCircle(fromX, fromY, toX, toY, radius, target, hitTime);
+}
+
+inline bool SweepCircle(float fromX, float fromY, float toX, float toY, float radius, const Obb& target, float& hitTime) {
+    return SweepCircleVsObb(fromX, fromY, toX, toY, radius, target, hitTime);
+}
+
+inline bool SweepCircle(float fromX, float fromY, float toX, float toY, float radius, const CollisionShape& target, float& hitTime) {
+    if (target.type == ShapeType::CIRCLE) return SweepCircleVsCircle(fromX, fromY, toX, toY, radius, target.circle, hitTime);
+    return SweepCircleVsObb(fromX, fromY, toX, toY, radius, target.box, hitTime);
+}
+
+#endif
@@ -0,0 +1,163 @@
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel() : currentTick(0), overflow(-1), freeList(-1), pendingCount(0) {
+    for (int i = 0; i < LEVEL0_SLOTS; ++i) level0[i] = -1;
+    for (int level = 0; level < UPPER_LEVELS; ++level) {
+        for (int i = 0; i < LEVEL_SLOTS; ++i) upper[level][i] = -1;
+    }
+}
+
+void TimerWheel::Reset(Uint32 now) {
+    // Nodes are freed rather than dropped so old handles keep a stale generation
+    for (int i = 0; i < static_cast<int>(nodes.size()); ++i) {
+        if (nodes[i].list != nullptr) FreeNode(i);
+    }
+    pendingCount = 0;
+    overflow = -1;
+    for (int i = 0; i < LEVEL0_SLOTS; ++i) level0[i] = -1;
+    for (int level = 0; level < UPPER_LEVELS; ++level) {
+        for (int i = 0; i < LEVEL_SLOTS; ++i) upper[level][i] = -1;
+    }
+    currentTick = now;
+}
+
+int TimerWheel::AllocateNode() {
+    if (freeList != -1) {
+        int index = freeList;
+        freeList = nodes[index].next;
+        return index;
+    }
+    nodes.push_back(TimerNode());
+    nodes.back().generation = 0;
+    nodes.back().list = nullptr;
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+void TimerWheel::FreeNode(int index) {
+    TimerNode& node = nodes[index];
+    node.callback = nullptr;
+    node.list = nullptr;
+    node.generation++;
+    node.next = freeList;
+    freeList = index;
+}
+
+void TimerWheel::Link(int index, int* list) {
+    TimerNode& node = nodes[index];
+    node.list = list;
+    node.prev = -1;
+    node.next = *list;
+    if (*list != -1) nodes[*list].prev = index;
+    *list = index;
+}
+
+void TimerWheel::Unlink(int index) {
+    TimerNode& node = nodes[index];
+    if (node.prev != -1) nodes[node.prev].next = node.next;
+    else *node.list = node.next;
+    if (node.next != -1) nodes[node.next].prev = node.prev;
+    node.list = nullptr;
+}
+
+// 'earliest' is the first tick whose level-0 slot has not been processed yet
+void TimerWheel::Place(int index, Uint32 earliest) {
+    Uint32 due = nodes[index].dueTime;
+    if (static_cast<Sint32>(due - earliest) < 0) due = earliest;
+    Uint32 delta = due - currentTick;
+
+    if (delta < (1u << LEVEL0_BITS)) {
+        Link(index, &level0[due & (LEVEL0_SLOTS - 1)]);
+        return;
+    }
+    for (int level = 0; level < UPPER_LEVELS; ++level) {
+        int shift = LEVEL0_BITS + level * LEVEL_BITS;
+        if (delta < (1u << (shift + LEVEL_BITS))) {
+            Link(index, &upper[level][(due >> shift) & (LEVEL_SLOTS - 1)]);
+            return;
+        }
+    }
+    Link(index, &overflow);
+}
+
+TimerHandle TimerWheel::Schedule(Uint32 dueTime, TimerCallback callback) {
+    int index = AllocateNode();
+    nodes[index].dueTime = dueTime;
+    nodes[index].callback = std::move(callback);
+    Place(index, currentTick + 1);   // already due: fire on the next tick
+    pendingCount++;
+
+    TimerHandle handle;
+    handle.index = index;
+    handle.generation = nodes[index].generation;
+    return handle;
+}
+
+bool TimerWheel::IsPending(const TimerHandle& handle) const {
+    if (handle.index < 0 || handle.index >= static_cast<int>(nodes.size())) return false;
+    const TimerNode& node = nodes[handle.index];
+    return node.generation == handle.generation && node.list != nullptr;
+}
+
+void TimerWheel::Cancel(TimerHandle& handle) {
+    if (IsPending(handle)) {
+        Unlink(handle.index);
+        FreeNode(handle.index);
+        pendingCount--;
+    }
+    handle = TimerHandle();
+}
+
+// Re-files every timer of a coarse slot relative to the current tick
+void TimerWheel::Cascade(int* list) {
+    int index = *list;
+    *list = -1;
+    while (index != -1) {
+        int next = nodes[index].next;
+        nodes[index].list = nullptr;
+        Place(index, currentTick);
+        index = next;
+    }
+}
+
+int TimerWheel::Advance(Uint32 now) {
+    int fired = 0;
+    while (static_cast<Sint32>(now - currentTick) > 0) {
+        currentTick++;
+
+        // Entering a new level-0 lap: pull the next coarse slots down, top level first
+        if ((currentTick & (LEVEL0_SLOTS - 1)) == 0) {
+            Uint32 block1 = currentTick >> LEVEL0_BITS;
+            if ((block1 & (LEVEL_SLOTS - 1)) == 0) {
+                Uint32 block2 = block1 >> LEVEL_BITS;
+                if ((block2 & (LEVEL_SLOTS - 1)) == 0) {
+                    Uint32 block3 = block2 >> LEVEL_BITS;
+                    if ((block3 & (LEVEL_SLOTS - 1)) == 0) Cascade(&overflow);
+                    Cascade(&upper[2][block3 & (LEVEL_SLOTS - 1)]);
+                }
+                Cascade(&upper[1][block2 & (LEVEL_SLOTS - 1)]);
+            }
+            Cascade(&upper[0][block1 & (LEVEL_SLOTS - 1)]);
+        }
+
+        // Fire one at a time: callbacks may schedule or cancel other timers
+        int* slot = &level0[currentTick & (LEVEL0_SLOTS - 1)];
+        while (*slot != -1) {
+            int index = *slot;
+            Unlink(index);
+            TimerCallback callback = std::move(nodes[index].callback);
+            FreeNode(index);
+            pendingCount--;
+            fired++;
+            if (callback) callback();
+        }
+    }
+    return fired;
+}
+
+int TimerWheel::GetPendingCount() const {
+    return pendingCount;
+}
+
+Uint32 TimerWheel::GetCurrentTime() const {
+    return currentTick;
+}
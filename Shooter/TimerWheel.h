@@ -0,0 +1,74 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <SDL.h>
+#include <functional>
+#include <vector>
+
+typedef std::function<void()> TimerCallback;
+
+// Identifies a scheduled timer. Stays safe to cancel after the timer fired or
+// was cancelled: the generation no longer matches and Cancel does nothing.
+struct TimerHandle {
+    int index;
+    Uint32 generation;
+
+    TimerHandle() : index(-1), generation(0) {}
+};
+
+// Hierarchical timing wheel with 1 ms ticks (SDL_GetTicks time). Level 0 has
+// 256 one-tick slots, levels 1-3 have 64 slots each covering 256, 16384 and
+// 1048576 ticks; anything further out waits in an overflow list. A timer sits
+// in the coarsest slot that still separates it from "now" and is moved down a
+// level when that slot comes round, so Advance only touches timers that are
+// about to fire, plus one slot check per elapsed tick.
+//
+// Callbacks run inside Advance and may schedule or cancel timers. A timer
+// scheduled for a time that already passed fires on the next tick.
+class TimerWheel {
+public:
+    TimerWheel();
+
+    void Reset(Uint32 now);   // drops every pending timer
+    TimerHandle Schedule(Uint32 dueTime, TimerCallback callback);
+    void Cancel(TimerHandle& handle);
+    bool IsPending(const TimerHandle& handle) const;
+
+    int Advance(Uint32 now);  // fires everything due up to now, returns how many fired
+
+    int GetPendingCount() const;
+    Uint32 GetCurrentTime() const;
+
+private:
+    struct TimerNode {
+        Uint32 dueTime;
+        Uint32 generation;
+        TimerCallback callback;
+        int prev, next;
+        int* list;            // head of the list this node is linked into, null when free
+    };
+
+    void Place(int index, Uint32 earliest);
+    void Link(int index, int* list);
+    void Unlink(int index);
+    void Cascade(int* list);
+    int AllocateNode();
+    void FreeNode(int index);
+
+    static const int LEVEL0_BITS = 8;
+    static const int LEVEL_BITS = 6;
+    static const int LEVEL0_SLOTS = 1 << LEVEL0_BITS;
+    static const int LEVEL_SLOTS = 1 << LEVEL_BITS;
+    static const int UPPER_LEVELS = 3;
+
+    Uint32 currentTick;
+    int level0[LEVEL0_SLOTS];
+    int upper[UPPER_LEVELS][LEVEL_SLOTS];
+    int overflow;
+
+    std::vector<TimerNode> nodes;
+    int freeList;
+    int pendingCount;
+};
+
+#endif
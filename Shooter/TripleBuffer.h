@@ -0,0 +1,43 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Lock-free single-producer / single-consumer triple buffer. The writer fills
+// the back slot and swaps it with the shared middle slot; the reader swaps the
+// middle slot into the front whenever a fresh one is waiting. Neither side
+// ever blocks, and the reader always sees the newest complete value.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : backIndex(0), middle(1), frontIndex(2) {}
+
+    // --- Writer side ---
+    T& BeginWrite() { return slots[backIndex]; }
+
+    void Publish() {
+        int previous = middle.exchange(backIndex | FRESH_BIT, std::memory_order_acq_rel);
+        backIndex = previous & INDEX_MASK;
+    }
+
+    // --- Reader side ---
+    bool Acquire() {
+        if ((middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) return false;
+        int previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T& Front() const { return slots[frontIndex]; }
+
+private:
+    static const int INDEX_MASK = 0x3;
+    static const int FRESH_BIT = 0x4;
+
+    T slots[3];
+    int backIndex;
+    std::atomic<int> middle;
+    int frontIndex;
+};
+
+#endif
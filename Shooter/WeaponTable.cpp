@@ -0,0 +1,193 @@
+#include "WeaponTable.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Same content as assets/weapons.txt, used when the file cannot be read
+static const char* const DEFAULT_WEAPONS =
+    "weapon single NORMAL 35 1000\n"
+    "shot 0 0 0\n"
+    "weapon double NORMAL 35 1000\n"
+    "shot 0 0 -7\n"
+    "shot 0 0 7\n"
+    "weapon triple NORMAL 35 1000\n"
+    "shot 0 0 0\n"
+    "shot -10 0 0\n"
+    "shot 10 0 0\n"
+    "weapon triple_powered POWERED 35 1000\n"
+    "shot 0 0 0\n"
+    "shot -10 0 0\n"
+    "shot 10 0 0\n"
+    "weapon sideways_powered POWERED 35 1000\n"
+    "shot 0 0 0\n"
+    "shot -90 0 0\n"
+    "shot 90 0 0\n"
+    "shot -10 0 0\n"
+    "shot 10 0 0\n"
+    "weapon sideways_super SUPER_POWERED 35 1000\n"
+    "shot 0 0 0\n"
+    "shot -90 0 0\n"
+    "shot 90 0 0\n"
+    "shot -10 0 0\n"
+    "shot 10 0 0\n"
+    "weapon sideways_extreme EXTREME_POWERED 35 1000\n"
+    "shot 0 0 0\n"
+    "shot -90 0 0\n"
+    "shot 90 0 0\n"
+    "shot -10 0 0\n"
+    "shot 10 0 0\n"
+    "weapon enemy_normal NORMAL 10 1000\n"
+    "shot 0 0 0\n"
+    "weapon enemy_fast POWERED 10 1000\n"
+    "shot 0 0 0\n"
+    "weapon enemy_tank EXTREME_POWERED 10 1000\n"
+    "shot 0 0 0\n"
+    "weapon enemy_quick SUPER_POWERED 10 1000\n"
+    "shot 0 0 -10\n"
+    "shot 0 0 10\n"
+    "weapon enemy_boss EXTREME_POWERED 10 1000\n"
+    "pattern FAN 7 0.26 6 0 0 0\n"
+    "pattern RING 24 0 4 0 0 0\n"
+    "pattern SPIRAL 16 0 4 0.006 0 0\n"
+    "pattern WAVE 5 0.35 5 0 40 0.1\n"
+    "level 1 single 1.0\n"
+    "level 2 double 1.15\n"
+    "level 3 triple 1.0\n"
+    "level 4 triple_powered 1.15\n"
+    "level 5 sideways_powered 1.0\n"
+    "level 6 sideways_super 1.15\n"
+    "level 7 sideways_extreme 1.0\n"
+    "enemy NORMAL enemy_normal\n"
+    "enemy FAST enemy_fast\n"
+    "enemy TANK enemy_tank\n"
+    "enemy QUICK enemy_quick\n"
+    "enemy BOSS enemy_boss\n";
+
+static bool ParseBulletType(const std::string& text, BulletType& type) {
+    if (text == "NORMAL")          { type = BulletType::NORMAL; return true; }
+    if (text == "POWERED")         { type = BulletType::POWERED; return true; }
+    if (text == "SUPER_POWERED")   { type = BulletType::SUPER_POWERED; return true; }
+    if (text == "EXTREME_POWERED") { type = BulletType::EXTREME_POWERED; return true; }
+    return false;
+}
+
+static bool ParsePatternShape(const std::string& text, PatternShape& shape) {
+    if (text == "RING")   { shape = PatternShape::RING; return true; }
+    if (text == "SPIRAL") { shape = PatternShape::SPIRAL; return true; }
+    if (text == "FAN")    { shape = PatternShape::FAN; return true; }
+    if (text == "WAVE")   { shape = PatternShape::WAVE; return true; }
+    return false;
+}
+
+static bool ParseEnemyType(const std::string& text, EnemyType& type) {
+    if (text == "NORMAL") { type = EnemyType::NORMAL; return true; }
+    if (text == "FAST")   { type = EnemyType::FAST; return true; }
+    if (text == "TANK")   { type = EnemyType::TANK; return true; }
+    if (text == "QUICK")  { type = EnemyType::QUICK; return true; }
+    if (text == "BOSS")   { type = EnemyType::BOSS; return true; }
+    return false;
+}
+
+WeaponTable::WeaponTable() {
+    for (int& weapon : enemyWeapons) weapon = -1;
+}
+
+bool WeaponTable::Load(const char* path) {
+    weapons.clear();
+    byName.clear();
+    levels.clear();
+    for (int& weapon : enemyWeapons) weapon = -1;
+
+    std::ifstream file(path);
+    if (file) {
+        Parse(file, path);
+    } else {
+        std::cerr << "WeaponTable: cannot open " << path << ", using built-in weapons" << std::endl;
+        std::istringstream builtIn(DEFAULT_WEAPONS);
+        Parse(builtIn, "built-in weapons");
+    }
+
+    std::sort(levels.begin(), levels.end(), [](const WeaponLevel& a, const WeaponLevel& b) { return a.level < b.level; });
+    std::cout << "Loaded " << weapons.size() << " weapons." << std::endl;
+    return file.is_open() && !weapons.empty();
+}
+
+void WeaponTable::Parse(std::istream& in, const char* source) {
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword) || keyword[0] == '#') continue;
+
+        bool ok = false;
+        if (keyword == "weapon") {
+            Weapon weapon;
+            std::string typeName;
+            ok = (fields >> weapon.name >> typeName >> weapon.damage >> weapon.cooldown) && ParseBulletType(typeName, weapon.bulletType);
+            if (ok) {
+                byName[weapon.name] = static_cast<int>(weapons.size());
+                weapons.push_back(weapon);
+            }
+        } else if (keyword == "shot") {
+            float degrees;
+            WeaponShot shot;
+            ok = !weapons.empty() && (fields >> degrees >> shot.forward >> shot.side);
+            if (ok) {
+                FastSinCos(degrees * FAST_DEG_TO_RAD, shot.turnS, shot.turnC);
+                weapons.back().shots.push_back(shot);
+            }
+        } else if (keyword == "pattern") {
+            PatternParams pattern;
+            std::string shapeName;
+            ok = !weapons.empty() &&
+                 (fields >> shapeName >> pattern.count >> pattern.spread >> pattern.speed >> pattern.spin
+                         >> pattern.waveAmplitude >> pattern.waveFrequency) &&
+                 ParsePatternShape(shapeName, pattern.shape) && pattern.count >= 1 && pattern.count <= PatternVolley::MAX_LANES;
+            if (ok) weapons.back().patterns.push_back(pattern);
+        } else if (keyword == "level") {
+            WeaponLevel entry;
+            std::string name;
+            ok = (fields >> entry.level >> name >> entry.fireRateMultiplier) && byName.count(name);
+            if (ok) {
+                entry.weapon = byName[name];
+                levels.push_back(entry);
+            }
+        } else if (keyword == "enemy") {
+            std::string typeName, name;
+            EnemyType type;
+            ok = (fields >> typeName >> name) && ParseEnemyType(typeName, type) && byName.count(name);
+            if (ok) enemyWeapons[static_cast<int>(type)] = byName[name];
+        }
+
+        if (!ok) {
+            std::cerr << "WeaponTable: " << source << ":" << lineNumber << ": cannot parse '" << line << "'" << std::endl;
+        }
+    }
+}
+
+const Weapon* WeaponTable::Find(const std::string& name) const {
+    auto it = byName.find(name);
+    return (it != byName.end()) ? &weapons[it->second] : nullptr;
+}
+
+const WeaponLevel* WeaponTable::GetLevel(int level) const {
+    const WeaponLevel* found = nullptr;
+    for (const WeaponLevel& entry : levels) {
+        if (entry.level > level) break;
+        found = &entry;
+    }
+    return found;
+}
+
+const Weapon* WeaponTable::GetWeapon(const WeaponLevel& entry) const {
+    return &weapons[entry.weapon];
+}
+
+const Weapon* WeaponTable::ForEnemy(EnemyType type) const {
+    int index = enemyWeapons[static_cast<int>(type)];
+    return (index >= 0) ? &weapons[index] : nullptr;
+}
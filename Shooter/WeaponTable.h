@@ -0,0 +1,67 @@
+#ifndef WEAPONTABLE_H
+#define WEAPONTABLE_H
+
+#include <SDL.h>
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+#include "Globals.h"
+#include "PatternEmitter.h"
+
+// One bullet of a weapon, relative to the shooter's heading. The turn is
+// stored as cos/sin so firing is a 2x2 rotation, no trig.
+struct WeaponShot {
+    float turnC, turnS;         // direction: heading turned by the shot angle
+    float forward, side;        // spawn offset along the heading and to its right
+};
+
+struct Weapon {
+    std::string name;
+    BulletType bulletType;
+    int damage;
+    Uint32 cooldown;            // ms between shots, before the shooter's firing rate
+    std::vector<WeaponShot> shots;
+    std::vector<PatternParams> patterns;   // enemies: one volley per shot, in turn, instead of 'shots'
+};
+
+// Player weapon from 'level' upward, until the next entry
+struct WeaponLevel {
+    int level;
+    int weapon;                 // index into WeaponTable::weapons
+    float fireRateMultiplier;   // applied once, on reaching this level
+};
+
+// Turns 'shot' to the heading (dirX, dirY): (vx, vy) is the unit bullet
+// direction and (offsetX, offsetY) the spawn offset from the muzzle
+inline void AimShot(const WeaponShot& shot, float dirX, float dirY, float& vx, float& vy, float& offsetX, float& offsetY) {
+    vx = dirX * shot.turnC - dirY * shot.turnS;
+    vy = dirX * shot.turnS + dirY * shot.turnC;
+    offsetX = dirX * shot.forward - dirY * shot.side;
+    offsetY = dirY * shot.forward + dirX * shot.side;
+}
+
+// Player and enemy weapons, read from assets/weapons.txt (see that file for
+// the format). A missing file falls back to the built-in table, which is the
+// same text; bad lines are reported and skipped.
+class WeaponTable {
+public:
+    WeaponTable();
+
+    bool Load(const char* path);
+
+    const Weapon* Find(const std::string& name) const;
+    const WeaponLevel* GetLevel(int level) const;   // last entry at or below 'level'
+    const Weapon* GetWeapon(const WeaponLevel& entry) const;
+    const Weapon* ForEnemy(EnemyType type) const;
+
+private:
+    void Parse(std::istream& in, const char* source);
+
+    std::vector<Weapon> weapons;
+    std::map<std::string, int> byName;
+    std::vector<WeaponLevel> levels;                // sorted by level
+    int enemyWeapons[ENEMY_TYPE_COUNT];     // -1: none
+};
+
+#endif
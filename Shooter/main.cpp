@@ -1,7 +1,9 @@
 #include "Game.h"
 #include "Globals.h"
+#include "AllocTracker.h"
 
 int main(int argc, char* argv[]) {
+    AllocTracker::Install();   // no-op unless built with TRACK_ALLOCATIONS
     Game game;
     if (!game.Init("SDL2 Game", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, SCREEN_WIDTH, SCREEN_HEIGHT, false)) {
         return -1;
@@ -15,8 +17,7 @@ int main(int argc, char* argv[]) {
     while (game.Running()) {
         frameStart = SDL_GetTicks();
         game.HandleEvents();
-        game.Update();
-        game.Render();
+        game.Update(); // Rendering happens on the render thread
         frameTime = SDL_GetTicks() - frameStart;
         if (frameTime < frameDelay) {
             SDL_Delay(frameDelay - frameTime);
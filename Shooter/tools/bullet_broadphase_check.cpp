@@ -0,0 +1,174 @@
+// Checks the grid broadphase of the player bullet phase against scanning every
+// enemy and obstacle, then times both at the Horde enemy cap. Mirrors
+// Game::UpdatePlayerBullets up to the mask test: the enemy grid is rebuilt from
+// the current positions with each sprite's half diagonal, the obstacle grid
+// is built once, and each bullet queries a circle around its path this tick.
+// Not part of the game build; from Shooter/tools:
+//   SDL="-I../../SDL2/x86_64-w64-mingw32/include/SDL2 -I../../SDL2_image-2.8.8/x86_64-w64-mingw32/include/SDL2 -I../../SDL2_ttf-2.24.0/x86_64-w64-mingw32/include/SDL2 -I../../SDL2_mixer-2.8.1/x86_64-w64-mingw32/include/SDL2"
+//   g++ -std=c++17 -O2 -I.. $SDL bullet_broadphase_check.cpp ../SpatialGrid.cpp ../SweptCollision.cpp ../Global.cpp -o bullet_broadphase_check && ./bullet_broadphase_check
+// Only the headers are needed; nothing links against SDL.
+// Exits non-zero if any bullet's first hit differs between the two.
+#include "SpatialGrid.h"
+#include "SweptCollision.h"
+#include "Globals.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+const int BULLET_COUNTS[] = { 1000, 4000, 16000, 32000 };
+const float WORLD_HALF_SIZE = 4000.0f;          // the horde spreads over several screens
+const float BULLET_HALF_SIZE = 1920.0f;         // bullets are culled 1.5 screens from the player
+const int OBSTACLE_COUNT = 75;                  // 5x5 loaded chunks at CHUNK_OBSTACLE_COUNT each
+const int TIMED_RUNS = 5;
+
+struct Target {
+    CollisionShape shape;
+    float centerX, centerY;
+    float halfDiagonal;
+};
+
+struct Path {
+    float fromX, fromY, toX, toY;
+    float radius;
+};
+
+struct Hit {
+    bool enemy;
+    int id;
+    float time;
+};
+
+template <typename F>
+static double TimeMs(F work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Enemy sizes and shapes as in Enemy's constructor and GetShape
+static Target MakeEnemy(std::mt19937& rng) {
+    static const int SIZES[] = { 110, 110, 170, 130 };
+    std::uniform_real_distribution<float> position(-WORLD_HALF_SIZE, WORLD_HALF_SIZE);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::uniform_int_distribution<int> type(0, 99);
+    float x = position(rng), y = position(rng);
+    int roll = type(rng);
+    if (roll == 0) {
+        float heading = angle(rng);
+        return { MakeObb(x, y, 300.0f, 300.0f, std::cos(heading), std::sin(heading)), x, y, 150.0f * std::sqrt(2.0f) };
+    }
+    float size = static_cast<float>(SIZES[roll % 4]);
+    return { Circle{x, y, size / 2.0f}, x, y, size / 2.0f * std::sqrt(2.0f) };
+}
+
+static Target MakeObstacle(std::mt19937& rng) {
+    std::uniform_real_distribution<float> position(-WORLD_HALF_SIZE, WORLD_HALF_SIZE);
+    std::uniform_real_distribution<float> size(50.0f, 150.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    float x = position(rng), y = position(rng), side = size(rng), heading = angle(rng);
+    return { MakeObb(x, y, side, side, std::cos(heading), std::sin(heading)), x, y, side / 2.0f * std::sqrt(2.0f) };
+}
+
+static Path MakeBullet(std::mt19937& rng) {
+    static const float DIAMETERS[] = { 20.0f, 25.0f, 30.0f, 35.0f };
+    std::uniform_real_distribution<float> position(-BULLET_HALF_SIZE, BULLET_HALF_SIZE);
+    std::uniform_real_distribution<float> speed(5.0f, 40.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::uniform_int_distribution<int> type(0, 3);
+    float x = position(rng), y = position(rng), step = speed(rng), heading = angle(rng);
+    return { x - std::cos(heading) * step, y - std::sin(heading) * step, x, y, DIAMETERS[type(rng)] / 2.0f };
+}
+
+static void Consider(const Path& path, const Target& target, bool enemy, int id, Hit& first) {
+    float hitTime;
+    if (!SweepCircle(path.fromX, path.fromY, path.toX, path.toY, path.radius, target.shape, hitTime)) return;
+    // Ties go to the lower id, enemies before obstacles, as in the game
+    if (hitTime < first.time || (hitTime == first.time && enemy == first.enemy && id < first.id)) {
+        first = { enemy, id, hitTime };
+    }
+}
+
+// Enemies first, then obstacles, as in the game
+static Hit ScanAll(const Path& path, const std::vector<Target>& enemies, const std::vector<Target>& obstacles) {
+    Hit first = { false, -1, 2.0f };
+    for (int i = 0; i < static_cast<int>(enemies.size()); ++i) Consider(path, enemies[i], true, i, first);
+    for (int i = 0; i < static_cast<int>(obstacles.size()); ++i) Consider(path, obstacles[i], false, i, first);
+    return first;
+}
+
+static Hit QueryGrids(const Path& path, const std::vector<Target>& enemies, const std::vector<Target>& obstacles,
+                      SpatialGrid& enemyGrid, SpatialGrid& obstacleGrid, std::vector<int>& gridHits) {
+    float dx = path.toX - path.fromX;
+    float dy = path.toY - path.fromY;
+    float centerX = path.fromX + dx * 0.5f;
+    float centerY = path.fromY + dy * 0.5f;
+    float radius = 0.5f * std::sqrt(dx * dx + dy * dy) + path.radius;
+
+    Hit first = { false, -1, 2.0f };
+    gridHits.clear();
+    enemyGrid.Query(centerX, centerY, radius, gridHits);
+    for (int id : gridHits) Consider(path, enemies[id], true, id, first);
+    gridHits.clear();
+    obstacleGrid.Query(centerX, centerY, radius, gridHits);
+    for (int id : gridHits) Consider(path, obstacles[id], false, id, first);
+    return first;
+}
+
+static void BuildGrid(SpatialGrid& grid, const std::vector<Target>& targets) {
+    grid.Clear();
+    for (int i = 0; i < static_cast<int>(targets.size()); ++i) {
+        grid.Insert(i, targets[i].centerX, targets[i].centerY, targets[i].halfDiagonal);
+    }
+    grid.Build();
+}
+
+int main() {
+    std::mt19937 rng(1);
+    std::vector<Target> enemies, obstacles;
+    for (int i = 0; i < HORDE_MAX_ENEMIES; ++i) enemies.push_back(MakeEnemy(rng));
+    for (int i = 0; i < OBSTACLE_COUNT; ++i) obstacles.push_back(MakeObstacle(rng));
+
+    SpatialGrid enemyGrid(ENEMY_GRID_CELL_SIZE);
+    SpatialGrid obstacleGrid(OBSTACLE_GRID_CELL_SIZE);
+    std::vector<int> gridHits;
+    BuildGrid(obstacleGrid, obstacles);
+    bool ok = true;
+
+    std::printf("%d enemies, %d obstacles\n", HORDE_MAX_ENEMIES, OBSTACLE_COUNT);
+    std::printf("%8s %6s %10s %12s %10s\n", "bullets", "hits", "mismatch", "scan ms", "grid ms");
+    for (int bulletCount : BULLET_COUNTS) {
+        std::vector<Path> bullets;
+        for (int i = 0; i < bulletCount; ++i) bullets.push_back(MakeBullet(rng));
+
+        // --- Same first hit either way ---
+        BuildGrid(enemyGrid, enemies);
+        int hits = 0, mismatches = 0;
+        for (const Path& path : bullets) {
+            Hit expected = ScanAll(path, enemies, obstacles);
+            Hit actual = QueryGrids(path, enemies, obstacles, enemyGrid, obstacleGrid, gridHits);
+            if (expected.id >= 0) hits++;
+            if (expected.id != actual.id || expected.enemy != actual.enemy || expected.time != actual.time) mismatches++;
+        }
+        if (mismatches > 0) ok = false;
+
+        // --- Speed: one tick of the phase, enemy grid rebuild included ---
+        volatile int sink = 0;
+        double scanMs = TimeMs([&] {
+            for (int run = 0; run < TIMED_RUNS; ++run) {
+                for (const Path& path : bullets) sink = sink + ScanAll(path, enemies, obstacles).id;
+            }
+        }) / TIMED_RUNS;
+        double gridMs = TimeMs([&] {
+            for (int run = 0; run < TIMED_RUNS; ++run) {
+                BuildGrid(enemyGrid, enemies);
+                for (const Path& path : bullets) sink = sink + QueryGrids(path, enemies, obstacles, enemyGrid, obstacleGrid, gridHits).id;
+            }
+        }) / TIMED_RUNS;
+        std::printf("%8d %6d %10d %12.2f %10.2f\n", bulletCount, hits, mismatches, scanMs, gridMs);
+    }
+
+    std::printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
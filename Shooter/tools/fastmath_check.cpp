@@ -0,0 +1,107 @@
+// Checks the accuracy claims in FastMath.h and times the fast paths against
+// libm. Not part of the game build; from Shooter/tools:
+//   g++ -std=c++17 -O2 -I.. fastmath_check.cpp ../FastMath.cpp -o fastmath_check && ./fastmath_check
+// Exits non-zero if an error bound is exceeded or a batch result differs
+// from the scalar one.
+#include "FastMath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// The "~" bounds in FastMath.h, with a little room for rounding
+const double ATAN2_MAX_ERROR = 1.5e-5;
+const double SINCOS_MAX_ERROR = 3e-7;
+const int SAMPLE_COUNT = 2000000;
+
+template <typename F>
+static double TimeMs(F work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> angle(-1e4f, 1e4f);
+
+    std::vector<float> xs(SAMPLE_COUNT), ys(SAMPLE_COUNT), angles(SAMPLE_COUNT);
+    std::vector<float> radians(SAMPLE_COUNT), sines(SAMPLE_COUNT), cosines(SAMPLE_COUNT);
+    for (int i = 0; i < SAMPLE_COUNT; ++i) {
+        xs[i] = coordinate(rng);
+        ys[i] = coordinate(rng);
+        angles[i] = angle(rng);
+    }
+    // Origin and the negative axes, where atan2 has its special cases
+    xs[0] = 0.0f;  ys[0] = 0.0f;
+    xs[1] = -1.0f; ys[1] = 0.0f;
+    xs[2] = 0.0f;  ys[2] = -3.0f;
+
+    // --- Accuracy against double precision libm ---
+    double atan2Error = 0.0;
+    double sinCosError = 0.0;
+    for (int i = 0; i < SAMPLE_COUNT; ++i) {
+        double exact = std::atan2(static_cast<double>(ys[i]), static_cast<double>(xs[i]));
+        atan2Error = std::max(atan2Error, std::fabs(exact - FastAtan2(ys[i], xs[i])));
+
+        float sine, cosine;
+        FastSinCos(angles[i], sine, cosine);
+        sinCosError = std::max(sinCosError, std::fabs(std::sin(static_cast<double>(angles[i])) - sine));
+        sinCosError = std::max(sinCosError, std::fabs(std::cos(static_cast<double>(angles[i])) - cosine));
+    }
+
+    // --- Batch must match scalar bit for bit ---
+    int mismatches = 0;
+    FastAtan2Batch(ys.data(), xs.data(), radians.data(), SAMPLE_COUNT);
+    FastSinCosBatch(angles.data(), sines.data(), cosines.data(), SAMPLE_COUNT);
+    for (int i = 0; i < SAMPLE_COUNT; ++i) {
+        float sine, cosine;
+        FastSinCos(angles[i], sine, cosine);
+        if (radians[i] != FastAtan2(ys[i], xs[i])) mismatches++;
+        if (sines[i] != sine || cosines[i] != cosine) mismatches++;
+    }
+
+    std::printf("atan2  max error %.3g (bound %.3g)\n", atan2Error, ATAN2_MAX_ERROR);
+    std::printf("sincos max error %.3g (bound %.3g)\n", sinCosError, SINCOS_MAX_ERROR);
+    std::printf("batch/scalar mismatches %d\n", mismatches);
+
+    // --- Speed against libm ---
+    volatile float sink = 0.0f;
+    double libmAtan2 = TimeMs([&] {
+        float sum = 0.0f;
+        for (int i = 0; i < SAMPLE_COUNT; ++i) sum += std::atan2(ys[i], xs[i]);
+        sink = sum;
+    });
+    double fastAtan2 = TimeMs([&] {
+        float sum = 0.0f;
+        for (int i = 0; i < SAMPLE_COUNT; ++i) sum += FastAtan2(ys[i], xs[i]);
+        sink = sum;
+    });
+    double batchAtan2 = TimeMs([&] { FastAtan2Batch(ys.data(), xs.data(), radians.data(), SAMPLE_COUNT); });
+    double libmSinCos = TimeMs([&] {
+        float sum = 0.0f;
+        for (int i = 0; i < SAMPLE_COUNT; ++i) sum += std::sin(angles[i]) + std::cos(angles[i]);
+        sink = sum;
+    });
+    double fastSinCos = TimeMs([&] {
+        float sum = 0.0f;
+        for (int i = 0; i < SAMPLE_COUNT; ++i) {
+            float sine, cosine;
+            FastSinCos(angles[i], sine, cosine);
+            sum += sine + cosine;
+        }
+        sink = sum;
+    });
+    double batchSinCos = TimeMs([&] { FastSinCosBatch(angles.data(), sines.data(), cosines.data(), SAMPLE_COUNT); });
+    (void)sink;
+
+    std::printf("atan2  libm %.1fms  fast %.1fms  batch %.1fms\n", libmAtan2, fastAtan2, batchAtan2);
+    std::printf("sincos libm %.1fms  fast %.1fms  batch %.1fms\n", libmSinCos, fastSinCos, batchSinCos);
+
+    bool ok = atan2Error <= ATAN2_MAX_ERROR && sinCosError <= SINCOS_MAX_ERROR && mismatches == 0;
+    std::printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// Checks ApplySeparation against a brute-force all-pairs pass, then times it
+// at several enemy counts with the density held constant, so the time per
+// enemy should stay flat as the count grows. Not part of the game build; from
+// Shooter/tools:
+//   SDL="-I../../SDL2/x86_64-w64-mingw32/include/SDL2 -I../../SDL2_image-2.8.8/x86_64-w64-mingw32/include/SDL2 -I../../SDL2_ttf-2.24.0/x86_64-w64-mingw32/include/SDL2 -I../../SDL2_mixer-2.8.1/x86_64-w64-mingw32/include/SDL2"
+//   g++ -std=c++17 -O2 -I.. $SDL separation_check.cpp ../EnemyStore.cpp ../SpatialGrid.cpp ../EntityHandle.cpp ../Global.cpp -o separation_check && ./separation_check
+// Only the headers are needed; nothing links against SDL.
+// Exits non-zero if any target velocity differs from the brute-force one.
+#include "EnemyStore.h"
+#include "SpatialGrid.h"
+#include "Globals.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+const int COUNTS[] = { 500, 1000, 2000, 4000, 8000, 16000 };
+const float AREA_PER_ENEMY = 150.0f * 150.0f;   // about one enemy per 150 px square, so most have neighbours
+const float NORMAL_RADIUS = 55.0f;             // 110 px sprites
+const float LARGE_RADIUS = 150.0f;             // TANK/BOSS sized, spans several cells
+const float MAX_DIFFERENCE = 1e-4f;            // the grid sums neighbours in another order
+const int TIMED_RUNS = 50;
+
+template <typename F>
+static double TimeMs(F work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void Populate(EnemyStore& store, int count, std::mt19937& rng) {
+    float side = std::sqrt(count * AREA_PER_ENEMY);
+    std::uniform_real_distribution<float> position(-side / 2.0f, side / 2.0f);
+    std::uniform_real_distribution<float> speed(1.0f, 5.0f);
+    std::uniform_real_distribution<float> coin(0.0f, 1.0f);
+    store.Clear();
+    for (int i = 0; i < count; ++i) {
+        float radius = (coin(rng) < 0.02f) ? LARGE_RADIUS : NORMAL_RADIUS;
+        store.Add(nullptr, position(rng), position(rng), speed(rng), radius);
+        store.active[i] = (coin(rng) < 0.9f) ? 1 : 0;   // coasting enemies push nobody but are still pushed away from
+    }
+    // Two enemies on the same spot, the spawn-point case
+    if (count > 2) {
+        store.x[1] = store.x[0];
+        store.y[1] = store.y[0];
+        store.radius[1] = store.radius[0];
+        store.active[0] = store.active[1] = 1;
+    }
+}
+
+// The same rule as ApplySeparation, over every pair
+static void BruteForceSeparation(EnemyStore& store, float weight, float padding) {
+    int count = store.GetCount();
+    for (int i = 0; i < count; ++i) {
+        if (!store.active[i]) continue;
+        float centerX = store.x[i] + store.radius[i];
+        float centerY = store.y[i] + store.radius[i];
+        float pushX = 0.0f, pushY = 0.0f;
+        for (int j = 0; j < count; ++j) {
+            if (j == i) continue;
+            float dx = centerX - (store.x[j] + store.radius[j]);
+            float dy = centerY - (store.y[j] + store.radius[j]);
+            float minDistance = store.radius[i] + store.radius[j] + padding;
+            float distanceSq = dx * dx + dy * dy;
+            if (distanceSq >= minDistance * minDistance) continue;
+
+            float distance = std::sqrt(distanceSq);
+            float strength = 1.0f - distance / minDistance;
+            if (distance > 0.001f) {
+                pushX += dx / distance * strength;
+                pushY += dy / distance * strength;
+            } else {
+                pushX += (i < j) ? -strength : strength;
+            }
+        }
+        store.targetVX[i] += pushX * store.speed[i] * weight;
+        store.targetVY[i] += pushY * store.speed[i] * weight;
+    }
+}
+
+int main() {
+    std::mt19937 rng(1);
+    EnemyStore store;
+    EnemyStore expected;
+    SpatialGrid grid(ENEMY_GRID_CELL_SIZE);
+    bool ok = true;
+
+    std::printf("%8s %12s %14s %12s\n", "enemies", "max diff", "ms / frame", "ns / enemy");
+    for (int count : COUNTS) {
+        Populate(store, count, rng);
+        expected = store;
+
+        // --- Same push as brute force ---
+        ApplySeparation(store, grid, ENEMY_SEPARATION_WEIGHT, ENEMY_SEPARATION_PADDING);
+        BruteForceSeparation(expected, ENEMY_SEPARATION_WEIGHT, ENEMY_SEPARATION_PADDING);
+        float maxDifference = 0.0f;
+        for (int i = 0; i < count; ++i) {
+            maxDifference = std::max(maxDifference, std::fabs(store.targetVX[i] - expected.targetVX[i]));
+            maxDifference = std::max(maxDifference, std::fabs(store.targetVY[i] - expected.targetVY[i]));
+        }
+        if (!(maxDifference <= MAX_DIFFERENCE)) ok = false;
+
+        // --- Speed: the grid rebuild and every query, as in one game frame ---
+        double totalMs = TimeMs([&] {
+            for (int run = 0; run < TIMED_RUNS; ++run) {
+                ApplySeparation(store, grid, ENEMY_SEPARATION_WEIGHT, ENEMY_SEPARATION_PADDING);
+            }
+        });
+        double frameMs = totalMs / TIMED_RUNS;
+        std::printf("%8d %12.3g %14.3f %12.0f\n", count, maxDifference, frameMs, frameMs * 1e6 / count);
+    }
+
+    std::printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
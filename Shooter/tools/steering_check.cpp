@@ -0,0 +1,90 @@
+// Checks that the SIMD SteerVelocities matches SteerVelocitiesScalar bit for
+// bit for every count from 0 to 1000, so the vector body and the scalar tail
+// are both exercised, then times the two. Not part of the game build; from
+// Shooter/tools, once for the SSE2 path and once (with -mavx) for the AVX one:
+//   SDL="-I../../SDL2/x86_64-w64-mingw32/include/SDL2 -I../../SDL2_image-2.8.8/x86_64-w64-mingw32/include/SDL2 -I../../SDL2_ttf-2.24.0/x86_64-w64-mingw32/include/SDL2 -I../../SDL2_mixer-2.8.1/x86_64-w64-mingw32/include/SDL2"
+//   g++ -std=c++17 -O2 -I.. $SDL steering_check.cpp ../EnemyStore.cpp ../SpatialGrid.cpp ../EntityHandle.cpp -o steering_check && ./steering_check
+//   g++ -std=c++17 -O2 -mavx -I.. $SDL steering_check.cpp ../EnemyStore.cpp ../SpatialGrid.cpp ../EntityHandle.cpp -o steering_check && ./steering_check
+// Only the headers are needed; nothing links against SDL.
+// Exits non-zero on any mismatch.
+#include "EnemyStore.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+const int MAX_COUNT = 1000;
+const float MAX_FORCES[] = { 0.05f, 0.3f, 10.0f };     // clamped, partly clamped, never clamped
+const int BENCH_COUNT = 4096;
+const int BENCH_ITERATIONS = 2000;
+
+template <typename F>
+static double TimeMs(F work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+#if defined(__AVX__)
+    std::printf("path: AVX\n");
+#elif defined(__SSE2__) || defined(_M_X64)
+    std::printf("path: SSE2\n");
+#else
+    std::printf("path: scalar\n");
+#endif
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> velocity(-6.0f, 6.0f);
+    std::uniform_real_distribution<float> speed(0.5f, 5.0f);
+
+    // --- SIMD against scalar, every count ---
+    int failedCounts = 0;
+    for (float maxForce : MAX_FORCES) {
+        for (int count = 0; count <= MAX_COUNT; ++count) {
+            std::vector<float> vx(count), vy(count), targetVX(count), targetVY(count), speeds(count);
+            for (int i = 0; i < count; ++i) {
+                vx[i] = velocity(rng);
+                vy[i] = velocity(rng);
+                targetVX[i] = velocity(rng);
+                targetVY[i] = velocity(rng);
+                speeds[i] = speed(rng);
+            }
+            // A standing enemy with no target: zero-length steer and velocity
+            if (count > 2) vx[1] = vy[1] = targetVX[1] = targetVY[1] = 0.0f;
+            // Already at the target: zero steer, non-zero velocity
+            if (count > 5) { targetVX[4] = vx[4]; targetVY[4] = vy[4]; }
+
+            std::vector<float> scalarVX = vx, scalarVY = vy;
+            SteerVelocities(vx.data(), vy.data(), targetVX.data(), targetVY.data(), speeds.data(), maxForce, count);
+            SteerVelocitiesScalar(scalarVX.data(), scalarVY.data(), targetVX.data(), targetVY.data(), speeds.data(),
+                                  maxForce, count);
+
+            int mismatches = 0;
+            for (int i = 0; i < count; ++i) {
+                if (vx[i] != scalarVX[i] || vy[i] != scalarVY[i]) mismatches++;
+            }
+            if (mismatches > 0) {
+                std::printf("count %d maxForce %g: %d mismatches\n", count, maxForce, mismatches);
+                failedCounts++;
+            }
+        }
+    }
+    std::printf("counts 0..%d: %d with mismatches\n", MAX_COUNT, failedCounts);
+
+    // --- Speed ---
+    std::vector<float> vx(BENCH_COUNT, 1.0f), vy(BENCH_COUNT, 1.0f), targetVX(BENCH_COUNT, 3.0f),
+                       targetVY(BENCH_COUNT, -2.0f), speeds(BENCH_COUNT, 2.0f);
+    double scalarMs = TimeMs([&] {
+        for (int k = 0; k < BENCH_ITERATIONS; ++k)
+            SteerVelocitiesScalar(vx.data(), vy.data(), targetVX.data(), targetVY.data(), speeds.data(), 0.3f, BENCH_COUNT);
+    });
+    double simdMs = TimeMs([&] {
+        for (int k = 0; k < BENCH_ITERATIONS; ++k)
+            SteerVelocities(vx.data(), vy.data(), targetVX.data(), targetVY.data(), speeds.data(), 0.3f, BENCH_COUNT);
+    });
+    std::printf("%d enemies x %d: scalar %.2fms  simd %.2fms\n", BENCH_COUNT, BENCH_ITERATIONS, scalarMs, simdMs);
+
+    std::printf("%s\n", failedCounts == 0 ? "OK" : "FAILED");
+    return failedCounts == 0 ? 0 : 1;
+}